@@ -0,0 +1,191 @@
+//===- svfg-rw.cpp -- SVFG write/read round trip -----------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // SVFG write/read round trip
+ //
+ // Builds the full SVFG of a program, writes it with SVFG::writeToFile and
+ // SVFG::writeBinaryFile, reads each file back into a new SVFG and compares
+ // the nodes, the edges and the points-to sets of both. Exits with 1 if any
+ // of them differs.
+ */
+
+#include "SVF-LLVM/LLVMUtil.h"
+#include "SVF-LLVM/SVFIRBuilder.h"
+#include "MSSA/SVFGBuilder.h"
+#include "WPA/Andersen.h"
+#include "Util/CommandLine.h"
+#include "Util/Options.h"
+#include <algorithm>
+#include <sstream>
+
+using namespace llvm;
+using namespace std;
+using namespace SVF;
+
+namespace
+{
+
+/*!
+ * Build an SVFG from a file written by SVFG::writeToFile or SVFG::writeBinaryFile,
+ * instead of from memory SSA
+ */
+class SVFGFileBuilder : public SVFGBuilder
+{
+public:
+    explicit SVFGFileBuilder(const string& f) : filename(f) {}
+
+protected:
+    void buildSVFG() override
+    {
+        svfg->readFile(filename);
+    }
+
+private:
+    string filename;
+};
+
+void printPointsTo(ostringstream& ss, const NodeBS& pts)
+{
+    ss << " {";
+    for (NodeID id : pts)
+        ss << " " << id;
+    ss << " }";
+}
+
+/// Kind, ICFG node and, for memory SSA nodes, the points-to set of the memory region
+string describeNode(const SVFGNode* node)
+{
+    ostringstream ss;
+    ss << "node " << node->getId() << " kind " << node->getNodeKind();
+    if (const ICFGNode* icfgNode = node->getICFGNode())
+        ss << " icfg " << icfgNode->getId();
+    if (const MRSVFGNode* mrNode = SVFUtil::dyn_cast<MRSVFGNode>(node))
+        printPointsTo(ss, mrNode->getPointsTo());
+    return ss.str();
+}
+
+/// Kind, endpoints, call site of call and return edges and points-to set of indirect edges
+string describeEdge(const SVFGEdge* edge)
+{
+    ostringstream ss;
+    ss << "edge " << edge->getSrcID() << " -> " << edge->getDstID() << " kind " << edge->getEdgeKind();
+    if (const CallDirSVFGEdge* callEdge = SVFUtil::dyn_cast<CallDirSVFGEdge>(edge))
+        ss << " cs " << callEdge->getCallSiteId();
+    else if (const RetDirSVFGEdge* retEdge = SVFUtil::dyn_cast<RetDirSVFGEdge>(edge))
+        ss << " cs " << retEdge->getCallSiteId();
+    else if (const CallIndSVFGEdge* callEdge = SVFUtil::dyn_cast<CallIndSVFGEdge>(edge))
+        ss << " cs " << callEdge->getCallSiteId();
+    else if (const RetIndSVFGEdge* retEdge = SVFUtil::dyn_cast<RetIndSVFGEdge>(edge))
+        ss << " cs " << retEdge->getCallSiteId();
+    if (const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge))
+        printPointsTo(ss, indEdge->getPointsTo());
+    return ss.str();
+}
+
+vector<string> describeOutEdges(const SVFGNode* node)
+{
+    vector<string> edges;
+    for (const SVFGEdge* edge : node->getOutEdges())
+        edges.push_back(describeEdge(edge));
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+/*!
+ * Compare the SVFG read from a file with the one it was written from, return the number of
+ * differences, printing the first few of them
+ */
+u32_t compareSVFGs(SVFG* written, SVFG* read, const string& filename)
+{
+    const u32_t maxPrinted = 10;
+    u32_t numOfDiffs = 0;
+    auto report = [&](const string& expected, const string& actual)
+    {
+        if (numOfDiffs++ < maxPrinted)
+            SVFUtil::errs() << filename << ": expected '" << expected << "', read '" << actual << "'\n";
+    };
+
+    if (written->getTotalNodeNum() != read->getTotalNodeNum())
+        report(to_string(written->getTotalNodeNum()) + " nodes", to_string(read->getTotalNodeNum()) + " nodes");
+    for (SVFG::iterator it = written->begin(), eit = written->end(); it != eit; ++it)
+    {
+        const SVFGNode* node = it->second;
+        if (!read->hasGNode(it->first))
+        {
+            report(describeNode(node), "no node");
+            continue;
+        }
+        const SVFGNode* readNode = read->getGNode(it->first);
+        if (describeNode(node) != describeNode(readNode))
+            report(describeNode(node), describeNode(readNode));
+
+        vector<string> edges = describeOutEdges(node);
+        vector<string> readEdges = describeOutEdges(readNode);
+        vector<string> diff;
+        set_difference(edges.begin(), edges.end(), readEdges.begin(), readEdges.end(), back_inserter(diff));
+        for (const string& edge : diff)
+            report(edge, "no edge");
+        diff.clear();
+        set_difference(readEdges.begin(), readEdges.end(), edges.begin(), edges.end(), back_inserter(diff));
+        for (const string& edge : diff)
+            report("no edge", edge);
+    }
+
+    SVFUtil::outs() << filename << ": " << (numOfDiffs ? to_string(numOfDiffs) + " differences" : "identical") << "\n";
+    return numOfDiffs;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    auto moduleNameVec =
+        OptionBase::parseOptions(argc, argv, "SVFG write/read round trip",
+                                 "[options] <input-bitcode...>");
+
+    SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
+    SVFIRBuilder builder(svfModule);
+    SVFIR* pag = builder.build();
+
+    AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
+    SVFGBuilder svfgBuilder;
+    SVFG* svfg = svfgBuilder.buildFullSVFG(ander);
+
+    /// files are written next to the working directory, named after the first module
+    string moduleName = moduleNameVec.front();
+    moduleName = moduleName.substr(moduleName.find_last_of('/') + 1);
+    const string textFile = moduleName + ".svfg";
+    const string binaryFile = moduleName + ".svfg.bin";
+    svfg->writeToFile(textFile);
+    svfg->writeBinaryFile(binaryFile);
+
+    u32_t numOfDiffs = 0;
+    for (const string& filename : {textFile, binaryFile})
+    {
+        SVFGFileBuilder fileBuilder(filename);
+        numOfDiffs += compareSVFGs(svfg, fileBuilder.buildFullSVFG(ander), filename);
+    }
+
+    LLVMModuleSet::releaseLLVMModuleSet();
+    return numOfDiffs ? 1 : 0;
+}
@@ -48,6 +48,7 @@
 
 #include "AE/Core/AbstractValue.h"
 #include "AE/Core/IntervalValue.h"
+#include "AE/Core/PersistentMap.h"
 #include "SVFIR/SVFVariables.h"
 #include "Util/Z3Expr.h"
 
@@ -60,7 +61,8 @@ class AbstractState
     friend class SVFIR2AbsState;
     friend class RelationSolver;
 public:
-    typedef Map<u32_t, AbstractValue> VarToAbsValMap;
+    /// Persistent maps, copying a state (e.g., into the abstract trace) shares the values it does not change
+    typedef PersistentMap<AbstractValue> VarToAbsValMap;
 
     typedef VarToAbsValMap AddrToAbsValMap;
 
@@ -123,7 +125,7 @@ public:
 
     AbstractState&operator=(const AbstractState&rhs)
     {
-        if (rhs != *this)
+        if (&rhs != this)
         {
             _varToAbsVal = rhs._varToAbsVal;
             _addrToAbsVal = rhs._addrToAbsVal;
@@ -153,10 +155,10 @@ public:
     AbstractState bottom() const
     {
         AbstractState inv = *this;
-        for (auto &item: inv._varToAbsVal)
+        for (const auto &item: _varToAbsVal)
         {
             if (item.second.isInterval())
-                item.second.getInterval().set_to_bottom();
+                inv._varToAbsVal[item.first].getInterval().set_to_bottom();
         }
         return inv;
     }
@@ -165,10 +167,10 @@ public:
     AbstractState top() const
     {
         AbstractState inv = *this;
-        for (auto &item: inv._varToAbsVal)
+        for (const auto &item: _varToAbsVal)
         {
             if (item.second.isInterval())
-                item.second.getInterval().set_to_top();
+                inv._varToAbsVal[item.first].getInterval().set_to_top();
         }
         return inv;
     }
@@ -329,21 +331,15 @@ public:
     bool equals(const AbstractState&other) const;
 
 
+    /// Only the entries which are not shared by both maps are compared
     static bool eqVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
     {
         if (lhs.size() != rhs.size()) return false;
-        for (const auto &item: lhs)
+        return lhs.forEachDiff(rhs, [&lhs](const VarToAbsValMap::value_type& item)
         {
-            auto it = rhs.find(item.first);
-            if (it == rhs.end())
-                return false;
-            if (!item.second.equals(it->second))
-                return false;
-            else
-            {
-            }
-        }
-        return true;
+            const AbstractValue* val = lhs.lookup(item.first);
+            return val && val->equals(item.second);
+        });
     }
 
     static bool lessThanVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
@@ -363,17 +359,12 @@ public:
     static bool geqVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
     {
         if (rhs.empty()) return true;
-        for (const auto &item: rhs)
+        return lhs.forEachDiff(rhs, [&lhs](const VarToAbsValMap::value_type& item)
         {
-            auto it = lhs.find(item.first);
-            if (it == lhs.end()) return false;
+            const AbstractValue* val = lhs.lookup(item.first);
             // judge from expr id
-            if (!it->second.getInterval().contain(
-                        item.second.getInterval()))
-                return false;
-
-        }
-        return true;
+            return val && val->getInterval().contain(item.second.getInterval());
+        });
     }
 
     bool operator==(const AbstractState&rhs) const
@@ -0,0 +1,381 @@
+//===- PersistentMap.h ----Persistent maps of abstract states-------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2022>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * PersistentMap.h
+ *
+ * A map from u32_t keys with structural sharing, a compressed hash-array
+ * mapped prefix tree (CHAMP) indexed by 5 bits of the key per level. A copy
+ * shares every node with the original, and a write copies only the nodes on
+ * the path to its key which are still shared, so copying a map is O(1) and a
+ * write is O(depth). Entries are not removed, so the shape of a tree only
+ * depends on its keys and two maps can be compared subtree by subtree,
+ * skipping the subtrees they share.
+ */
+
+#ifndef Z3_EXAMPLE_PERSISTENTMAP_H
+#define Z3_EXAMPLE_PERSISTENTMAP_H
+
+#include "Util/GeneralType.h"
+#include <array>
+#include <iterator>
+#include <memory>
+
+namespace SVF
+{
+
+template<typename V>
+class PersistentMap
+{
+public:
+    typedef u32_t key_type;
+    typedef V mapped_type;
+    typedef std::pair<const u32_t, V> value_type;
+
+private:
+    static constexpr u32_t BitsPerLevel = 5;
+    static constexpr u32_t LevelMask = (1u << BitsPerLevel) - 1;
+    static constexpr u32_t MaxDepth = (32 + BitsPerLevel - 1) / BitsPerLevel;
+
+    typedef std::shared_ptr<value_type> EntryPtr;
+
+    struct Node
+    {
+        u32_t dataMap{0};	///< slots holding an entry
+        u32_t nodeMap{0};	///< slots holding a subtree
+        std::vector<EntryPtr> entries;	///< in slot order, an entry is shared by copies until written
+        std::vector<std::shared_ptr<Node>> children;	///< in slot order
+    };
+    typedef std::shared_ptr<Node> NodePtr;
+
+    static inline u32_t slotBit(u32_t key, u32_t shift)
+    {
+        return 1u << ((key >> shift) & LevelMask);
+    }
+
+    static inline u32_t slotIndex(u32_t map, u32_t bit)
+    {
+        return __builtin_popcount(map & (bit - 1));
+    }
+
+public:
+    class const_iterator
+    {
+        friend class PersistentMap;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef PersistentMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
+
+        const_iterator() = default;
+
+        inline reference operator*() const
+        {
+            const Frame& frame = path[depth - 1];
+            return *frame.node->entries[frame.pos];
+        }
+
+        inline pointer operator->() const
+        {
+            return &**this;
+        }
+
+        inline const_iterator& operator++()
+        {
+            ++path[depth - 1].pos;
+            settle();
+            return *this;
+        }
+
+        inline const_iterator operator++(int)
+        {
+            const_iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        inline bool operator==(const const_iterator& rhs) const
+        {
+            if (depth == 0 || rhs.depth == 0)
+                return depth == rhs.depth;
+            return path[depth - 1].node == rhs.path[rhs.depth - 1].node &&
+                   path[depth - 1].pos == rhs.path[rhs.depth - 1].pos;
+        }
+
+        inline bool operator!=(const const_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        /// pos enumerates the entries of a node and then its children
+        struct Frame
+        {
+            const Node* node;
+            u32_t pos;
+        };
+
+        inline void push(const Node* node, u32_t pos)
+        {
+            path[depth++] = {node, pos};
+        }
+
+        /// Move to the first entry at or after the current position
+        void settle()
+        {
+            while (depth > 0)
+            {
+                Frame& frame = path[depth - 1];
+                u32_t numOfEntries = frame.node->entries.size();
+                if (frame.pos < numOfEntries)
+                    return;
+                u32_t child = frame.pos - numOfEntries;
+                if (child < frame.node->children.size())
+                {
+                    push(frame.node->children[child].get(), 0);
+                    continue;
+                }
+                if (--depth > 0)
+                    ++path[depth - 1].pos;
+            }
+        }
+
+        std::array<Frame, MaxDepth + 1> path;
+        u32_t depth{0};
+    };
+    typedef const_iterator iterator;
+
+    PersistentMap() = default;
+
+    PersistentMap(std::initializer_list<value_type> init)
+    {
+        for (const value_type& item : init)
+            (*this)[item.first] = item.second;
+    }
+
+    /// Copies share all nodes
+    //@{
+    PersistentMap(const PersistentMap& rhs) = default;
+    PersistentMap(PersistentMap&& rhs) noexcept : root(std::move(rhs.root)), numOfEntries(rhs.numOfEntries)
+    {
+        rhs.numOfEntries = 0;
+    }
+    PersistentMap& operator=(const PersistentMap& rhs) = default;
+    PersistentMap& operator=(PersistentMap&& rhs) noexcept
+    {
+        root = std::move(rhs.root);
+        numOfEntries = rhs.numOfEntries;
+        rhs.numOfEntries = 0;
+        return *this;
+    }
+    //@}
+
+    inline size_t size() const
+    {
+        return numOfEntries;
+    }
+
+    inline bool empty() const
+    {
+        return numOfEntries == 0;
+    }
+
+    inline void clear()
+    {
+        root.reset();
+        numOfEntries = 0;
+    }
+
+    const_iterator begin() const
+    {
+        const_iterator it;
+        if (root)
+        {
+            it.push(root.get(), 0);
+            it.settle();
+        }
+        return it;
+    }
+
+    inline const_iterator end() const
+    {
+        return const_iterator();
+    }
+
+    const_iterator find(u32_t key) const
+    {
+        const_iterator it;
+        const Node* node = root.get();
+        for (u32_t shift = 0; node; shift += BitsPerLevel)
+        {
+            u32_t bit = slotBit(key, shift);
+            if (node->dataMap & bit)
+            {
+                u32_t idx = slotIndex(node->dataMap, bit);
+                if (node->entries[idx]->first != key)
+                    return end();
+                it.push(node, idx);
+                return it;
+            }
+            if (!(node->nodeMap & bit))
+                return end();
+            u32_t idx = slotIndex(node->nodeMap, bit);
+            it.push(node, node->entries.size() + idx);
+            node = node->children[idx].get();
+        }
+        return end();
+    }
+
+    /// The value of key, nullptr if it is not in the map
+    const V* lookup(u32_t key) const
+    {
+        const Node* node = root.get();
+        for (u32_t shift = 0; node; shift += BitsPerLevel)
+        {
+            u32_t bit = slotBit(key, shift);
+            if (node->dataMap & bit)
+            {
+                const value_type& entry = *node->entries[slotIndex(node->dataMap, bit)];
+                return entry.first == key ? &entry.second : nullptr;
+            }
+            if (!(node->nodeMap & bit))
+                return nullptr;
+            node = node->children[slotIndex(node->nodeMap, bit)].get();
+        }
+        return nullptr;
+    }
+
+    inline size_t count(u32_t key) const
+    {
+        return lookup(key) ? 1 : 0;
+    }
+
+    inline const V& at(u32_t key) const
+    {
+        const V* val = lookup(key);
+        assert(val && "key not in the map?");
+        return *val;
+    }
+
+    /// The value of key for writing, default constructed if it is not in the map.
+    /// Shared nodes on the path and a shared entry are copied first. The reference
+    /// stays valid across insertions of other keys, as for std::unordered_map.
+    V& operator[](u32_t key)
+    {
+        Node* node = getUnique(root);
+        for (u32_t shift = 0;; shift += BitsPerLevel)
+        {
+            u32_t bit = slotBit(key, shift);
+            if (node->dataMap & bit)
+            {
+                u32_t idx = slotIndex(node->dataMap, bit);
+                EntryPtr& entry = node->entries[idx];
+                if (entry->first == key)
+                {
+                    if (entry.use_count() > 1)
+                        entry = std::make_shared<value_type>(*entry);
+                    return entry->second;
+                }
+                // two keys in this slot, push the entry down into a new subtree
+                NodePtr sub = std::make_shared<Node>();
+                sub->dataMap = slotBit(entry->first, shift + BitsPerLevel);
+                sub->entries.push_back(std::move(entry));
+                node->entries.erase(node->entries.begin() + idx);
+                node->dataMap ^= bit;
+                node->children.insert(node->children.begin() + slotIndex(node->nodeMap, bit), sub);
+                node->nodeMap |= bit;
+                node = sub.get();
+            }
+            else if (node->nodeMap & bit)
+            {
+                node = getUnique(node->children[slotIndex(node->nodeMap, bit)]);
+            }
+            else
+            {
+                u32_t idx = slotIndex(node->dataMap, bit);
+                node->entries.insert(node->entries.begin() + idx, std::make_shared<value_type>(key, V()));
+                node->dataMap |= bit;
+                ++numOfEntries;
+                return node->entries[idx]->second;
+            }
+        }
+    }
+
+    /// Whether both maps are the same tree, e.g., one is an unchanged copy of the other
+    inline bool shares(const PersistentMap& rhs) const
+    {
+        return root == rhs.root;
+    }
+
+    /// Visit the entries of rhs, skipping those and the subtrees which rhs shares
+    /// with this map, until fn returns false. fn may write into this map.
+    template<typename Fn>
+    bool forEachDiff(const PersistentMap& rhs, Fn fn) const
+    {
+        return forEachDiff(root.get(), rhs.root.get(), fn);
+    }
+
+private:
+    static Node* getUnique(NodePtr& node)
+    {
+        if (!node)
+            node = std::make_shared<Node>();
+        else if (node.use_count() > 1)
+            node = std::make_shared<Node>(*node);
+        return node.get();
+    }
+
+    template<typename Fn>
+    static bool forEachDiff(const Node* lhs, const Node* rhs, Fn& fn)
+    {
+        if (lhs == rhs || rhs == nullptr)
+            return true;
+        u32_t idx = 0;
+        for (u32_t map = rhs->dataMap; map; map &= map - 1, ++idx)
+        {
+            u32_t bit = map & (~map + 1);
+            const EntryPtr& entry = rhs->entries[idx];
+            if (lhs && (lhs->dataMap & bit) && lhs->entries[slotIndex(lhs->dataMap, bit)] == entry)
+                continue;
+            if (!fn(*entry))
+                return false;
+        }
+        idx = 0;
+        for (u32_t map = rhs->nodeMap; map; map &= map - 1, ++idx)
+        {
+            u32_t bit = map & (~map + 1);
+            const Node* lhsChild = lhs && (lhs->nodeMap & bit) ? lhs->children[slotIndex(lhs->nodeMap, bit)].get() : nullptr;
+            if (!forEachDiff(lhsChild, rhs->children[idx].get(), fn))
+                return false;
+        }
+        return true;
+    }
+
+    NodePtr root;
+    size_t numOfEntries{0};
+};
+
+} // end namespace SVF
+
+#endif //Z3_EXAMPLE_PERSISTENTMAP_H
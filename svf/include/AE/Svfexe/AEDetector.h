@@ -86,6 +86,21 @@ public:
      */
     virtual void reportBug() = 0;
 
+    /**
+     * @brief Create a detector of the same kind for a worker analysing one entry in parallel.
+     * @return The new detector, or nullptr if this detector cannot be used in parallel.
+     */
+    virtual std::unique_ptr<AEDetector> clone() const
+    {
+        return nullptr;
+    }
+
+    /**
+     * @brief Merge the bugs found by a detector created by clone.
+     * @param worker The detector of the worker.
+     */
+    virtual void mergeBugs(AEDetector& worker) {}
+
     /**
      * @brief Get the kind of the detector.
      * @return The kind of the detector.
@@ -253,6 +268,13 @@ public:
             bugLoc.insert(loc); // Otherwise, mark this location as reported
         }
 
+        // A worker keeps its bugs until they are merged in the order of entries
+        if (deferBugs)
+        {
+            deferredBugs.emplace_back(e.what(), node);
+            return;
+        }
+
         // Add the bug to the recorder with details from the event stack
         recoder.addAbsExecBug(GenericBug::FULLBUFOVERFLOW, eventStack, 0, 0, 0, 0);
         nodeToBugInfo[node] = e.what(); // Record the exception information for the node
@@ -275,6 +297,29 @@ public:
         }
     }
 
+    /**
+     * @brief Create a detector for a worker, which defers its bugs until they are merged.
+     * @return The new detector.
+     */
+    std::unique_ptr<AEDetector> clone() const override
+    {
+        std::unique_ptr<BufOverflowDetector> detector = std::make_unique<BufOverflowDetector>();
+        detector->deferBugs = true;
+        return detector;
+    }
+
+    /**
+     * @brief Add the bugs of a worker's detector to the reporter, in the order it found them.
+     * @param worker The detector of the worker.
+     */
+    void mergeBugs(AEDetector& worker) override
+    {
+        BufOverflowDetector& other = *SVFUtil::cast<BufOverflowDetector>(&worker);
+        for (const auto& bug : other.deferredBugs)
+            addBugToReporter(AEException(bug.first), bug.second);
+        other.deferredBugs.clear();
+    }
+
     /**
      * @brief Initializes external API buffer overflow check rules.
      */
@@ -319,5 +364,7 @@ private:
     Set<std::string> bugLoc; ///< Set of locations where bugs have been reported.
     SVFBugReport recoder; ///< Recorder for abstract execution bugs.
     Map<const ICFGNode*, std::string> nodeToBugInfo; ///< Maps ICFG nodes to bug information.
+    bool deferBugs{false}; ///< Whether this is the detector of a worker.
+    std::vector<std::pair<std::string, const ICFGNode*>> deferredBugs; ///< Bugs of a worker, in the order found.
 };
 }
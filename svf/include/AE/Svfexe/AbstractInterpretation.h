@@ -96,6 +96,46 @@ public:
         }
         return generalNumMap["ICFG_Node_Trace"];
     }
+    u32_t& getSummaryHits()
+    {
+        if (generalNumMap.count("Summary_Hit_Num") == 0)
+        {
+            generalNumMap["Summary_Hit_Num"] = 0;
+        }
+        return generalNumMap["Summary_Hit_Num"];
+    }
+    u32_t& getSubsumedSummaryHits()
+    {
+        if (generalNumMap.count("Summary_Subsumed_Hit_Num") == 0)
+        {
+            generalNumMap["Summary_Subsumed_Hit_Num"] = 0;
+        }
+        return generalNumMap["Summary_Subsumed_Hit_Num"];
+    }
+    u32_t& getSummaryMisses()
+    {
+        if (generalNumMap.count("Summary_Miss_Num") == 0)
+        {
+            generalNumMap["Summary_Miss_Num"] = 0;
+        }
+        return generalNumMap["Summary_Miss_Num"];
+    }
+    u32_t& getEvalReuses()
+    {
+        if (generalNumMap.count("Eval_Reuse_Num") == 0)
+        {
+            generalNumMap["Eval_Reuse_Num"] = 0;
+        }
+        return generalNumMap["Eval_Reuse_Num"];
+    }
+    u32_t& getEvictedStates()
+    {
+        if (generalNumMap.count("Evicted_State_Num") == 0)
+        {
+            generalNumMap["Evicted_State_Num"] = 0;
+        }
+        return generalNumMap["Evicted_State_Num"];
+    }
 };
 
 /// AbstractInterpretation is same as Abstract Execution
@@ -118,10 +158,11 @@ public:
     /// Program entry
     void analyse();
 
+    /// The instance analysing on the calling thread, i.e., a worker of the parallel mode or the global one
     static AbstractInterpretation& getAEInstance()
     {
         static AbstractInterpretation instance;
-        return instance;
+        return workerInstance ? *workerInstance : instance;
     }
 
     void addDetector(std::unique_ptr<AEDetector> detector)
@@ -245,6 +286,24 @@ private:
     /// Mark recursive functions in the call graph
     void initWTO();
 
+    /// Entry functions: main, and every function without callers if Options::RunUncallFuncs()
+    std::vector<const CallGraphNode*> collectEntryFuns() const;
+
+    /// Analyse an entry function, a function without callers starts from the global state
+    void handleEntryFun(const CallGraphNode* cgn);
+
+    /// Analyse the entries on Options::AEThreads() workers and merge their results in entry order
+    void analyseInParallel(const std::vector<const CallGraphNode*>& entries);
+
+    /// Create every field object the workers may ask for, so that they never add nodes to the SVFIR
+    void createGepObjVars();
+
+    /// A fresh instance with its own trace and detectors, sharing the WTOs of this one
+    std::unique_ptr<AbstractInterpretation> createWorker(const Set<const CallICFGNode*>& initialCheckpoints) const;
+
+    /// Merge the checkpoints, statistics and bugs of a worker which finished its entry
+    void mergeWorker(AbstractInterpretation& worker, const Set<const CallICFGNode*>& initialCheckpoints);
+
     /**
      * Check if execution state exist by merging states of predecessor nodes
      *
@@ -286,6 +345,16 @@ private:
 
     void handleWTOComponent(const ICFGWTOComp* wtoComp);
 
+    /// Handle the top-level components of a function, evicting states no later component reads
+    void handleFunWTOComponents(const CallGraphNode* fun);
+
+    /// Nodes of a function whose states may be evicted after each of its top-level components
+    const std::vector<std::vector<const ICFGNode*>>& getEvictionPlan(const CallGraphNode* fun);
+
+    /// Whether a function is analysed at most once in this run, so that no later call joins its states
+    bool isEnteredOnce(const CallGraphNode* fun);
+    bool isInCycle(const CallGraphNode* fun, const ICFGNode* node) const;
+
 
     /**
      * handle SVF Statement like CmpStmt, CallStmt, GepStmt, LoadStmt, StoreStmt, etc.
@@ -358,8 +427,10 @@ private:
     AEStat* stat;
 
     std::vector<const CallICFGNode*> callSiteStack;
-    Map<const CallGraphNode*, ICFGWTO*> funcToWTO;
+    Map<const CallGraphNode*, ICFGWTO*> funcToWTO;	///< owned by the global instance, read-only in workers
     Set<const CallGraphNode*> recursiveFuns;
+    const ICFGNode* curEntryNode{nullptr};	///< entry node of the entry function being analysed
+    static thread_local AbstractInterpretation* workerInstance;	///< instance of the calling worker, nullptr outside workers
 
 
     AbstractState& getAbsStateFromTrace(const ICFGNode* node)
@@ -396,6 +467,52 @@ private:
     virtual bool isIndirectCall(const CallICFGNode* callNode);
     virtual void indirectCallFunPass(const CallICFGNode* callNode);
 
+    /// A summary of a callee: its input restricted to what it may read, the part of its exit state it wrote,
+    /// and the entry values of the locations outside the input it wrote, which a conditional write joins
+    struct FunSummary
+    {
+        u64_t hash;
+        AbstractState input;
+        AbstractState output;
+        AbstractState writtenEntry;
+    };
+
+    /// Analyse the callee of a call site, or reuse a summary whose input subsumes the current one
+    void handleCallee(const CallGraphNode* callee);
+
+    /// Summaries of callees
+    //@{
+    AbstractState getSummaryInput(const FunEntryICFGNode* entry, const AbstractState& entryAs);
+    AbstractState getSummaryOutput(const FunExitICFGNode* exit, const AbstractState& input,
+                                   const AbstractState& entryAs, const AbstractState& exitAs) const;
+    static AbstractState getWrittenEntry(const AbstractState& input, const AbstractState& output, const AbstractState& entryAs);
+    const FunSummary* findSummary(const CallGraphNode* callee, const AbstractState& input, u64_t hash,
+                                  const AbstractState& entryAs);
+    static u64_t hashSummaryInput(const AbstractState& input);
+    static bool subsumes(const AbstractState& lhs, const AbstractState& rhs);
+    //@}
+
+    /// Uses of the statements of a node, and the values used and changed by its last evaluation
+    struct NodeEvalInfo
+    {
+        bool eligible{true};	///< false for calls and phis, whose results depend on other nodes
+        bool evaluated{false};
+        bool readsAllMem{false};	///< a load through a pointer defined in the node itself
+        std::vector<NodeID> uses;	///< top-level variables read
+        std::vector<NodeID> defs;	///< top-level variables written
+        std::vector<NodeID> loadPtrs;	///< pointers loaded from
+        std::vector<NodeID> storePtrs;	///< pointers stored to
+        AbstractState lastUses;	///< values of uses and of loaded memory at the last evaluation
+        AbstractState changes;	///< values written by the last evaluation
+    };
+
+    /// Reuse of node evaluations, see Options::AEReuseEvals()
+    //@{
+    NodeEvalInfo* getNodeEvalInfo(const ICFGNode* node);
+    bool reuseLastEvaluation(const ICFGNode* node, const NodeEvalInfo& info);
+    void recordEvaluation(const ICFGNode* node, NodeEvalInfo& info, const AbstractState& input);
+    //@}
+
     // there data should be shared with subclasses
     Map<std::string, std::function<void(const CallICFGNode*)>> func_map;
 
@@ -405,6 +522,13 @@ private:
     std::vector<std::unique_ptr<AEDetector>> detectors;
     AbsExtAPI* utils;
 
+    Map<const CallGraphNode*, std::deque<FunSummary>> funToSummaries;	///< at most Options::AESummaryLimit() per function, oldest first
+    Set<u32_t> globalObjs;	///< objects pointed to by global variables, roots of the memory a callee may read
+    bool globalObjsCollected{false};
+    Map<const ICFGNode*, NodeEvalInfo> nodeEvalInfo;
+    Map<const CallGraphNode*, std::vector<std::vector<const ICFGNode*>>> funToEvictionPlan;	///< see Options::AEEvictStates()
+    Map<const CallGraphNode*, bool> funToEnteredOnce;	///< see isEnteredOnce
+
     // according to varieties of cmp insts,
     // maybe var X var, var X const, const X var, const X const
     // we accept 'var X const' 'var X var' 'const X const'
@@ -82,6 +82,40 @@ public:
     /// Handle out-of-budget dpm
     void handleOutOfBudgetDpm(const CxtLocDPItem& dpm);
 
+    /// Adaptive scheduling of queries
+    //@{
+    enum QuerySchedule
+    {
+        RefineWithContext,	///< worth the context budget
+        KeepFlowSingleton,	///< flow-sensitive answer has at most one object
+        FellBackOutOfBudget	///< context refinement ran out of budget, the flow-sensitive answer is kept
+    };
+    /// Estimated cost of a query, only used to order queries: its backward SVFG reachability,
+    /// nodes on value-flow cycles counted twice
+    u32_t estimateQueryCost(NodeID id);
+    /// Cheap context-insensitive pass, keeps its answer if context refinement cannot help
+    QuerySchedule computeFlowPtsFirst(NodeID id);
+    /// Points-to of the context-insensitive pass / of the empty context, valid before finalize()
+    const PointsTo& getFlowPts(NodeID id);
+    PointsTo getEmptyCxtPts(NodeID id);
+    //@}
+
+    /// Answer a query from the cross-run query cache / record its answer there
+    //@{
+    bool answerFromQueryCache(const CxtVar& var);
+    void addToQueryCache(const CxtVar& var);
+    //@}
+
+    /// Take over the results of queries answered by another ContextDDA of a parallel query pool
+    void mergeQueryResults(ContextDDA* worker, const std::vector<NodeID>& queries);
+
+    /// Also drop the points-to recorded for the queried pointers
+    virtual void clearCachedPointsTo() override
+    {
+        DDAVFSolver<CxtVar,CxtPtSet,CxtLocDPItem>::clearCachedPointsTo();
+        clearPts();
+    }
+
     /// Override parent method
     virtual CxtPtSet getConservativeCPts(const CxtLocDPItem& dpm) override
     {
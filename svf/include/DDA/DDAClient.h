@@ -42,6 +42,8 @@
 namespace SVF
 {
 
+class ContextDDA;
+
 /**
  * General DDAClient which queries all top level pointers by default.
  */
@@ -97,6 +99,11 @@ public:
         return module;
     }
     virtual void answerQueries(PointerAnalysis* pta);
+    /// Answer queries with pta and workers (solvers of the same kind) in parallel,
+    /// then merge the results of the workers into pta.
+    virtual void answerQueriesInParallel(PointerAnalysis* pta, const std::vector<PointerAnalysis*>& workers);
+    /// Answer queries in the order of their estimated cost, refining with contexts only where it may help
+    virtual void answerQueriesByCost(ContextDDA* pta);
 
     virtual inline void performStat(PointerAnalysis*) {}
 
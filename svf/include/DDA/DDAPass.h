@@ -53,7 +53,7 @@ public:
     typedef OrderedSet<const SVFGEdge*> SVFGEdgeSet;
     typedef std::vector<PointerAnalysis*> PTAVector;
 
-    DDAPass() : _pta(nullptr), _client(nullptr) {}
+    DDAPass() : _pta(nullptr), _client(nullptr), _serverShutdown(false) {}
     ~DDAPass();
 
     /// Interface expose to users of our pointer analysis, given Value infos
@@ -89,8 +89,22 @@ private:
     void collectCxtInsenEdgeForRecur(PointerAnalysis* pta, const SVFG* svfg,SVFGEdgeSet& insensitveEdges);
     void collectCxtInsenEdgeForVFCycle(PointerAnalysis* pta, const SVFG* svfg,const SVFGSCC* svfgSCC, SVFGEdgeSet& insensitveEdges);
 
+    /// Server mode: keep the solver and its caches alive and answer requests one at a time
+    /// from stdin ("-") or a Unix-domain socket until the input ends or a client sends "shutdown"
+    //@{
+    void serveQueries(const std::string& endpoint);
+    void serveSocket(const std::string& path);
+    /// Answer one request line, return false if the session ends
+    bool answerRequest(const std::string& request, std::string& reply);
+    void setQueryBudget(u32_t budget);
+    /// Points-to and alias of pointers in the empty context, valid before finalize()
+    PointsTo queryPts(NodeID id);
+    AliasResult queryAlias(NodeID id1, NodeID id2);
+    //@}
+
     std::unique_ptr<PointerAnalysis> _pta;	///<  pointer analysis to be executed.
     DDAClient* _client;		///<  DDA client used
+    bool _serverShutdown;	///<  whether a server client asked to stop serving
 
 };
 
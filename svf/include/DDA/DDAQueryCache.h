@@ -0,0 +1,157 @@
+//===- DDAQueryCache.h -- Persistent cache of resolved DDA queries------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * DDAQueryCache.h
+ *
+ * Resolved demand-driven queries, (pointer, context) -> points-to set, kept on
+ * disk across runs. NodeIDs and call site IDs are not stable once the program
+ * changes, so the cache names a variable by its owner function and its rank
+ * among the variables of that function, and a call site by its caller, its
+ * rank among the ICFG nodes of the caller and its callee. Every query records
+ * the functions it depends on and the objects loaded along its value-flows; a
+ * query is dropped on load as soon as the content hash or the hash of the call
+ * edges of one of these functions differs from the current program, as soon as
+ * a changed function or one of its callees may store (by Andersen's analysis)
+ * to one of these objects, or when the set of functions has changed.
+ */
+
+#ifndef DDAQUERYCACHE_H_
+#define DDAQUERYCACHE_H_
+
+#include "SVFIR/SVFIR.h"
+#include "Graphs/PTACallGraph.h"
+#include "MemoryModel/PointerAnalysis.h"
+
+namespace SVF
+{
+
+class DDAQueryCache
+{
+public:
+    /// A context-sensitive variable, context is empty for flow-sensitive queries
+    typedef std::pair<NodeID, CallStrCxt> CachedVar;
+    typedef std::vector<CachedVar> CachedPts;
+    typedef OrderedMap<CachedVar, CachedPts> QueryToPtsMap;
+    typedef Set<const SVFFunction*> FunctionSet;
+
+    DDAQueryCache(SVFIR* p, PTACallGraph* cg, PointerAnalysis* a);
+
+    /// Read the queries of a previous run which are still valid, return false if there is no usable file
+    bool readFromFile(const std::string& filename);
+
+    /// Write the valid queries of the previous run and those answered in this run
+    void writeToFile(const std::string& filename) const;
+
+    /// Cached points-to of a query, nullptr if it has to be computed
+    inline const CachedPts* getCachedPts(const CachedVar& query) const
+    {
+        QueryToPtsMap::const_iterator it = queryToPts.find(query);
+        if (it == queryToPts.end())
+            return nullptr;
+        return &it->second;
+    }
+
+    /// Record a function visited while answering queries of this run
+    inline void addDependence(const SVFFunction* fun)
+    {
+        visitedFuns.insert(fun);
+    }
+
+    /// Record the objects a load visited while answering queries of this run may read
+    inline void addReadObjects(const PointsTo& pts)
+    {
+        for (NodeID obj : pts)
+            readObjs.set(pag->getBaseObjVar(obj));
+    }
+
+    /// Record the answer of a query; it depends on every function visited and every object read so far
+    void addCachedPts(const CachedVar& query, const CachedPts& pts);
+
+    inline u32_t getNumOfStaleQueries() const
+    {
+        return numOfStaleQueries;
+    }
+
+private:
+    typedef std::vector<std::string> Dependences;
+    typedef Map<std::string, u64_t> FunNameToHashMap;
+
+    /// Stable name of a variable / call site in the text format
+    //@{
+    std::string getStableName(NodeID id) const;
+    std::string getStableName(const CachedVar& var) const;
+    std::string getStableCallSiteName(CallSiteID csId) const;
+    //@}
+
+    /// Map a stable name of the text format back to this run, false if it does not exist any more
+    //@{
+    bool getNodeID(const std::string& owner, u32_t rank, s64_t offset, NodeID& id);
+    bool getCallSiteID(const std::string& owner, u32_t rank, const std::string& callee, CallSiteID& csId);
+    bool readCachedVar(std::istringstream& ss, CachedVar& var);
+    //@}
+
+    /// Name of the owner function of a variable, globals are owned by "@"
+    static inline std::string getOwnerName(const SVFFunction* fun)
+    {
+        return fun ? fun->getName() : "@";
+    }
+
+    /// Owner function of a variable, gep objects are named after their base object
+    const SVFFunction* getOwner(NodeID id) const;
+
+    /// Content hash of a function's SVFIR statements, or of the globals if fun is nullptr
+    u64_t computeFunctionHash(const SVFFunction* fun) const;
+    u64_t hashStmt(const SVFStmt* stmt) const;
+    u64_t hashVar(NodeID id) const;
+
+    /// Hash of the call edges into and out of a function
+    u64_t computeCallEdgeHash(const SVFFunction* fun) const;
+
+    /// Functions a query depends on: every visited function plus the owners of its variables
+    void addOwners(const CachedVar& var, OrderedSet<std::string>& deps) const;
+
+    /// Base objects a changed function or any of its callees may store to (Andersen mod)
+    NodeBS computeModifiedObjects(const Set<std::string>& changedFuns) const;
+
+    SVFIR* pag;
+    PTACallGraph* callGraph;
+    PointerAnalysis* ander;			///< whole-program analysis giving the objects loads and stores access
+    QueryToPtsMap queryToPts;			///< queries answered so far
+    OrderedMap<CachedVar, Dependences> queryToDeps;	///< functions each query depends on
+    OrderedMap<CachedVar, NodeBS> queryToReadObjs;	///< base objects each query may read
+    FunNameToHashMap funHashes;			///< content hash of each function in this run
+    FunNameToHashMap funCallHashes;		///< call edge hash of each function in this run
+    u64_t funSetHash;				///< hash of the names of all functions in this run
+    Map<std::string, const SVFFunction*> nameToFun;
+    Map<const SVFFunction*, std::vector<NodeID>> ownerToVars;	///< variables of each owner in NodeID order
+    Map<NodeID, u32_t> varToRank;		///< rank of a variable among those of its owner
+    Map<const SVFFunction*, std::vector<const ICFGNode*>> funToICFGNodes;	///< ICFG nodes of each function in block order
+    Map<const ICFGNode*, u32_t> icfgNodeToRank;	///< rank of an ICFG node among those of its function
+    FunctionSet visitedFuns;			///< functions visited by the queries of this run
+    NodeBS readObjs;				///< base objects read by the loads visited in this run
+    u32_t numOfStaleQueries;
+};
+
+} // End namespace SVF
+
+#endif /* DDAQUERYCACHE_H_ */
@@ -55,6 +55,9 @@ public:
     u32_t _NumOfStrongUpdates;
     u32_t _NumOfMustAliases;
     u32_t _NumOfInfeasiblePath;
+    u32_t _NumOfQueryCacheHit;	///< queries answered by the cross-run query cache
+    u32_t _NumOfSummaries;		///< function summaries built
+    u32_t _NumOfSummaryUses;	///< edges leaving a summary followed during traversal
 
     u64_t _NumOfStep;
     u64_t _NumOfStepInCycle;
@@ -75,12 +78,31 @@ public:
 
     void getNumOfOOBQuery();
 
+    /// Record the end-to-end time of one query
+    inline void addQueryLatency(double time)
+    {
+        _QueryLatencies.push_back(time);
+    }
+
+    /// Record how an adaptively scheduled query was answered
+    inline void addQueryProfile(NodeID ptr, u32_t cost, const std::string& schedule, u32_t flowPtsSize, u32_t ptsSize, double time)
+    {
+        _QueryProfiles.push_back({ptr, cost, schedule, flowPtsSize, ptsSize, time});
+    }
+
+    /// Write the per-query cost profile as CSV
+    void writeQueryProfile(const std::string& filename) const;
+
+    /// Accumulate the statistics of another solver of a parallel query pool
+    void mergeStat(const DDAStat& other);
+
 private:
     FlowDDA* flowDDA;
     ContextDDA* contextDDA;
 
     u32_t _TotalNumOfQuery;
     u32_t _TotalNumOfOutOfBudgetQuery;
+    u32_t _MergedNumOfOutOfBudgetQuery;	///< out-of-budget queries of merged pool workers
     u32_t _TotalNumOfDPM;
     u32_t _TotalNumOfStrongUpdates;
     u32_t _TotalNumOfMustAliases;
@@ -103,6 +125,22 @@ private:
 
     NUMStatMap NumPerQueryStatMap;
 
+    std::vector<double> _QueryLatencies;	///< time of each query
+
+    struct QueryProfile
+    {
+        NodeID ptr;
+        u32_t cost;			///< estimated cost
+        std::string schedule;	///< how the query was answered
+        u32_t flowPtsSize;	///< size of the context-insensitive answer
+        u32_t ptsSize;		///< size of the final answer
+        double time;
+    };
+    std::vector<QueryProfile> _QueryProfiles;	///< adaptively scheduled queries
+
+    /// Latency of the given percentile over all queries
+    double getQueryLatencyPercentile(const std::vector<double>& sorted, u32_t percentile) const;
+
     void initDefault();
 
 public:
@@ -31,9 +31,11 @@
 #define VALUEFLOWDDA_H_
 
 #include "DDA/DDAStat.h"
+#include "DDA/DDAQueryCache.h"
 #include "Graphs/SCC.h"
 #include "MSSA/SVFGBuilder.h"
 #include "MemoryModel/PointsTo.h"
+#include "Util/Options.h"
 #include "WPA/Andersen.h"
 #include <algorithm>
 
@@ -59,10 +61,28 @@ public:
     typedef OrderedMap<NodeID, DPTItemSet> LocToDPMVecMap;
     typedef OrderedSet<const SVFGEdge* > ConstSVFGEdgeSet;
     typedef SVFGEdge::SVFGEdgeSetTy SVFGEdgeSet;
+    /// An in-edge of a summary node, src is the index of the summary node the value flows
+    /// from unless the edge leaves the summary
+    struct SummaryEdge
+    {
+        u32_t dst;
+        u32_t src;
+        bool inner;
+        const SVFGEdge* edge;
+    };
+    /// A function summary: the copy/phi nodes (top-level) or memory phi nodes (address-taken)
+    /// whose value-flows reach a formal-out (nodes[0]), and their in-edges in breadth-first order
+    struct FunSummary
+    {
+        std::vector<const SVFGNode*> nodes;
+        std::vector<SummaryEdge> edges;
+    };
+    typedef Map<NodeID, FunSummary> NodeToSummaryMap;
+    typedef OrderedMap<NodePair, FunSummary> ObjToSummaryMap;
     typedef OrderedMap<const SVFGNode*, DPTItemSet> StoreToPMSetMap;
 
     ///Constructor
-    DDAVFSolver(): outOfBudgetQuery(false),_pag(nullptr),_svfg(nullptr),_ander(nullptr),_callGraph(nullptr), _callGraphSCC(nullptr), _svfgSCC(nullptr), ddaStat(nullptr)
+    DDAVFSolver(): outOfBudgetQuery(false),_pag(nullptr),_svfg(nullptr),_ander(nullptr),_callGraph(nullptr), _callGraphSCC(nullptr), _svfgSCC(nullptr), ddaStat(nullptr), queryCache(nullptr), queryBudget(0)
     {
     }
     /// Destructor
@@ -87,6 +107,50 @@ public:
         _callGraph = nullptr;
         _callGraphSCC = nullptr;
     }
+    /// Answer queries from / record them into a cache persisted across runs
+    inline void setQueryCache(DDAQueryCache* cache)
+    {
+        queryCache = cache;
+    }
+    /// Override the step budget of the following queries, 0 restores the command-line budget.
+    /// Cached points-to is dropped if the budget changes after some dpm ran out of budget.
+    inline void setQueryBudget(u32_t budget)
+    {
+        if (budget != queryBudget && !outOfBudgetDpms.empty())
+            clearCachedPointsTo();
+        queryBudget = budget;
+    }
+    /// Connect indirect calls resolved by another solver (a worker of a parallel query pool)
+    void mergeIndirectCalls(const PTACallGraph::CallEdgeMap& resolved)
+    {
+        SVFGEdgeSet svfgEdges;
+        for (typename PTACallGraph::CallEdgeMap::const_iterator it = resolved.begin(), eit = resolved.end(); it != eit; ++it)
+        {
+            const CallICFGNode* cs = it->first;
+            for (const SVFFunction* callee : it->second)
+            {
+                if (_callGraph->getIndCallMap()[cs].insert(callee).second)
+                {
+                    _callGraph->addIndirectCallGraphEdge(cs, cs->getCaller(), callee);
+                    _svfg->connectCallerAndCallee(cs, callee, svfgEdges);
+                }
+            }
+        }
+        if (!svfgEdges.empty())
+            _callGraphSCC->find();
+    }
+    /// Whether the last query ran out of budget
+    inline bool isOutOfBudgetQuery() const
+    {
+        return outOfBudgetQuery;
+    }
+    /// Drop the points-to cached for all dpms resolved so far
+    virtual void clearCachedPointsTo()
+    {
+        dpmToTLCPtSetMap.clear();
+        dpmToADCPtSetMap.clear();
+        outOfBudgetDpms.clear();
+    }
     /// Return candidate pointers for DDA
     inline NodeBS& getCandidateQueries()
     {
@@ -177,6 +241,10 @@ protected:
         {
             handleAddr(pts,dpm,SVFUtil::cast<AddrSVFGNode>(node));
         }
+        else if(SVFUtil::isa<FormalRetSVFGNode>(node) && Options::DDASummary())
+        {
+            backtraceAlongSummary(pts,dpm,getDirectSummary(node),false);
+        }
         else if (SVFUtil::isa<CopySVFGNode, PHISVFGNode, ActualParmSVFGNode,
                  FormalParmSVFGNode, ActualRetSVFGNode,
                  FormalRetSVFGNode, NullPtrSVFGNode>(node))
@@ -243,6 +311,11 @@ protected:
                 }
             }
         }
+        else if(SVFUtil::isa<FormalOUTSVFGNode>(node) && Options::DDASummary())
+        {
+            if (_pag->isConstantObj(dpm.getCurNodeID()) == false)
+                backtraceAlongSummary(pts,dpm,getIndirectSummary(node,dpm.getCurNodeID()),true);
+        }
         else if(SVFUtil::isa<MRSVFGNode>(node))
         {
             backtraceAlongIndirectVF(pts,dpm);
@@ -254,7 +327,15 @@ protected:
     /// recompute points-to for value-flow cycles and indirect calls
     void reCompute(const DPIm& dpm)
     {
-        /// re-compute due to indirect calls
+        reComputeForIndirectCalls(dpm);
+
+        /// re-compute for transitive closures
+        SVFGEdgeSet edgeSet(dpm.getLoc()->getOutEdges());
+        reComputeForEdges(dpm,edgeSet,false);
+    }
+    /// re-compute due to indirect calls
+    void reComputeForIndirectCalls(const DPIm& dpm)
+    {
         SVFGEdgeSet newIndirectEdges;
         if(_pag->isFunPtr(dpm.getCurNodeID()))
         {
@@ -266,10 +347,6 @@ protected:
         if(!newIndirectEdges.empty())
             _callGraphSCC->find();
         reComputeForEdges(dpm,newIndirectEdges,true);
-
-        /// re-compute for transitive closures
-        SVFGEdgeSet edgeSet(dpm.getLoc()->getOutEdges());
-        reComputeForEdges(dpm,edgeSet,false);
     }
 
     /// Traverse along out edges to find all nodes which may be affected by locDPM.
@@ -332,6 +409,17 @@ protected:
         outOfBudgetQuery = false;
         ddaStat->_NumOfStep = 0;
     }
+    /// Record the functions visited by the current query as dependences of the query cache
+    inline void addQueryCacheDependences()
+    {
+        for(typename LocToDPMVecMap::const_iterator it = locToDpmSetMap.begin(),eit = locToDpmSetMap.end(); it!=eit; ++it)
+        {
+            const SVFGNode* node = _svfg->getSVFGNode(it->first);
+            queryCache->addDependence(node->getFun());
+            if (const LoadSVFGNode* load = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+                queryCache->addReadObjects(_ander->getPts(load->getPAGSrcNodeID()));
+        }
+    }
     /// Reset visited map if the current query is out-of-budget
     inline void OOBResetVisited()
     {
@@ -387,6 +475,160 @@ protected:
         }
     }
 
+    /// Function summaries: the copy/phi nodes (top-level) or memory phi nodes (address-taken)
+    /// that reach a formal-out of a function, with their in-edges. They only follow intra-procedural
+    /// edges, which carry no context and are never added by on-the-fly call graph refinement, so a
+    /// summary is computed once and reused by every query and every context.
+    ///@{
+    const FunSummary& getDirectSummary(const SVFGNode* formalRet)
+    {
+        typename NodeToSummaryMap::iterator it = directSummaries.find(formalRet->getId());
+        if (it != directSummaries.end())
+            return it->second;
+        DOSTAT(ddaStat->_NumOfSummaries++);
+        FunSummary& summary = directSummaries[formalRet->getId()];
+        buildSummary(summary, formalRet, [](const SVFGEdge* edge)
+        {
+            return SVFUtil::isa<DirectSVFGEdge>(edge);
+        }, [](const SVFGEdge* edge)
+        {
+            return edge->getEdgeKind() == SVFGEdge::IntraDirectVF && SVFUtil::isa<CopySVFGNode, IntraPHISVFGNode>(edge->getSrcNode());
+        });
+        return summary;
+    }
+    const FunSummary& getIndirectSummary(const SVFGNode* formalOut, NodeID obj)
+    {
+        NodePair key(formalOut->getId(), obj);
+        typename ObjToSummaryMap::iterator it = indirectSummaries.find(key);
+        if (it != indirectSummaries.end())
+            return it->second;
+        DOSTAT(ddaStat->_NumOfSummaries++);
+        FunSummary& summary = indirectSummaries[key];
+        buildSummary(summary, formalOut, [obj](const SVFGEdge* edge)
+        {
+            const IndirectSVFGEdge* indirEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge);
+            return indirEdge && indirEdge->getPointsTo().test(obj);
+        }, [](const SVFGEdge* edge)
+        {
+            return edge->getEdgeKind() == SVFGEdge::IntraIndirectVF && SVFUtil::isa<IntraMSSAPHISVFGNode>(edge->getSrcNode());
+        });
+        return summary;
+    }
+    template<typename EdgeFilter, typename InnerEdge>
+    void buildSummary(FunSummary& summary, const SVFGNode* formalOut, EdgeFilter followEdge, InnerEdge isInner)
+    {
+        Map<const SVFGNode*, u32_t> nodeToIdx;
+        nodeToIdx[formalOut] = 0;
+        summary.nodes.push_back(formalOut);
+        for (u32_t i = 0; i < summary.nodes.size(); ++i)
+        {
+            for (const SVFGEdge* edge : summary.nodes[i]->getInEdges())
+            {
+                if (!followEdge(edge))
+                    continue;
+                SummaryEdge summaryEdge = {i, 0, isInner(edge), edge};
+                if (summaryEdge.inner)
+                {
+                    std::pair<typename Map<const SVFGNode*, u32_t>::iterator, bool> res =
+                        nodeToIdx.emplace(edge->getSrcNode(), summary.nodes.size());
+                    if (res.second)
+                        summary.nodes.push_back(edge->getSrcNode());
+                    summaryEdge.src = res.first->second;
+                }
+                summary.edges.push_back(summaryEdge);
+            }
+        }
+    }
+    /// Resolve a formal-out through its summary. The summary nodes get the dpms the plain backward
+    /// traversal would create, each is charged to the budget and cached like a visited dpm, and
+    /// their points-to is solved over the summary edges, so the results are the same as without
+    /// summaries. Summary nodes already visited keep their cached (possibly partial out-of-budget)
+    /// points-to and are not expanded again, as are those reached after the query ran out of budget.
+    void backtraceAlongSummary(CPtSet& pts, const DPIm& oldDpm, const FunSummary& summary, bool indirect)
+    {
+        u32_t numOfNodes = summary.nodes.size();
+        std::vector<DPIm> dpms(numOfNodes, oldDpm);
+        std::vector<CPtSet> nodePts(numOfNodes);
+        std::vector<bool> reached(numOfNodes, false);
+        std::vector<bool> expanded(numOfNodes, false);
+        std::vector<bool> feasible(summary.edges.size(), false);
+        reached[0] = expanded[0] = true;
+        for (u32_t i = 0; i < summary.edges.size(); ++i)
+        {
+            const SummaryEdge& summaryEdge = summary.edges[i];
+            if (!expanded[summaryEdge.dst])
+                continue;
+            const DPIm& dstDpm = dpms[summaryEdge.dst];
+            const SVFGNode* src = summaryEdge.edge->getSrcNode();
+            NodeID ptr = indirect ? dstDpm.getCurNodeID() : getSVFG()->getLHSTopLevPtr(src)->getId();
+            if (!summaryEdge.inner)
+            {
+                DOSTAT(ddaStat->_NumOfSummaryUses++);
+                backwardPropDpm(nodePts[summaryEdge.dst],ptr,dstDpm,summaryEdge.edge);
+                continue;
+            }
+            DPIm dpm(dstDpm);
+            dpm.setLocVar(src,ptr);
+            if (handleBKCondition(dpm,summaryEdge.edge) == false)
+                continue;
+            feasible[i] = true;
+            if (reached[summaryEdge.src])
+                continue;
+            reached[summaryEdge.src] = true;
+            if (indirect)
+                addLoadDpmAndCVar(dpm,getLoadDpm(dstDpm),getLoadCVar(dstDpm));
+            DOSTAT(ddaStat->_NumOfDPM++);
+            dpms[summaryEdge.src] = dpm;
+            if (isbkVisited(dpm))
+                continue;
+            markbkVisited(dpm);
+            addDpmToLoc(dpm);
+            expanded[summaryEdge.src] = (testOutOfBudget(dpm) == false);
+        }
+
+        /// solve the summary nodes, the others contribute what is cached for them
+        for (u32_t i = 1; i < numOfNodes; ++i)
+        {
+            if (reached[i] && !expanded[i])
+                nodePts[i] = getCachedPointsTo(dpms[i]);
+        }
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (u32_t i = 0; i < summary.edges.size(); ++i)
+            {
+                const SummaryEdge& summaryEdge = summary.edges[i];
+                if (feasible[i] && expanded[summaryEdge.dst] && unionDDAPts(nodePts[summaryEdge.dst], nodePts[summaryEdge.src]))
+                    changed = true;
+            }
+        }
+
+        /// cache the points-to of the expanded summary nodes, and re-compute the visited dpms
+        /// outside the summary which they reach, as updateCachedPointsTo does for a plain traversal
+        Set<const SVFGNode*> expandedNodes;
+        for (u32_t i = 0; i < numOfNodes; ++i)
+        {
+            if (expanded[i])
+                expandedNodes.insert(summary.nodes[i]);
+        }
+        for (u32_t i = 1; i < numOfNodes; ++i)
+        {
+            if (!expanded[i] || unionDDAPts(dpms[i], nodePts[i]) == false)
+                continue;
+            reComputeForIndirectCalls(dpms[i]);
+            SVFGEdgeSet edgeSet;
+            for (SVFGEdge* edge : summary.nodes[i]->getOutEdges())
+            {
+                if (expandedNodes.find(edge->getDstNode()) == expandedNodes.end())
+                    edgeSet.insert(edge);
+            }
+            reComputeForEdges(dpms[i],edgeSet,false);
+        }
+        unionDDAPts(pts, nodePts[0]);
+    }
+    ///@}
+
     /// Backward traverse for top-level pointers of load/store statements
     ///@{
     inline void startNewPTCompFromLoadSrc(CPtSet& pts, const DPIm& oldDpm)
@@ -730,10 +972,6 @@ protected:
             outOfBudgetQuery = true;
         return isOutOfBudgetDpm(dpm) || outOfBudgetQuery;
     }
-    inline bool isOutOfBudgetQuery() const
-    {
-        return outOfBudgetQuery;
-    }
     inline void addOutOfBudgetDpm(const DPIm& dpm)
     {
         outOfBudgetDpms.insert(dpm);
@@ -789,6 +1027,10 @@ protected:
     StoreToPMSetMap storeToDPMs;	///< map store to set of DPM which have been stong updated there
     DDAStat* ddaStat;				///< DDA stat
     SVFGBuilder svfgBuilder;			///< SVFG Builder
+    NodeToSummaryMap directSummaries;	///< formal-ret SVFG node to its summary
+    ObjToSummaryMap indirectSummaries;	///< (formal-out SVFG node, object) to its summary
+    DDAQueryCache* queryCache;		///< cross-run cache of resolved queries, nullptr if disabled
+    u32_t queryBudget;				///< step budget of a query, 0 if given by the command line
 };
 
 } // End namespace SVF
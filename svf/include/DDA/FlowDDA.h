@@ -76,6 +76,15 @@ public:
     /// Handle out-of-budget dpm
     void handleOutOfBudgetDpm(const LocDPItem& dpm);
 
+    /// Answer a query from the cross-run query cache / record its answer there
+    //@{
+    bool answerFromQueryCache(NodeID id);
+    void addToQueryCache(NodeID id);
+    //@}
+
+    /// Take over the results of queries answered by another FlowDDA of a parallel query pool
+    void mergeQueryResults(FlowDDA* worker, const std::vector<NodeID>& queries);
+
     /// Handle condition for flow analysis (backward analysis)
     virtual bool handleBKCondition(LocDPItem& dpm, const SVFGEdge* edge) override;
 
@@ -105,6 +114,13 @@ public:
     /// (4) not involved in recursion
     virtual bool isHeapCondMemObj(const NodeID& var, const StoreSVFGNode* store) override;
 
+    /// Also drop the points-to recorded for the queried pointers
+    virtual void clearCachedPointsTo() override
+    {
+        DDAVFSolver<NodeID,PointsTo,LocDPItem>::clearCachedPointsTo();
+        clearAllPts();
+    }
+
     /// Override parent method
     virtual inline PointsTo getConservativeCPts(const LocDPItem& dpm) override
     {
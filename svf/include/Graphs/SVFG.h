@@ -106,6 +106,13 @@ protected:
     std::unique_ptr<MemSSA> mssa;
     PointerAnalysis* pta;
 
+    /// Memory regions, defs and versions materialised when loading a binary snapshot
+    //@{
+    std::vector<std::unique_ptr<MemRegion>> loadedMRs;
+    std::vector<std::unique_ptr<MSSADEF>> loadedDefs;
+    std::vector<std::unique_ptr<MRVer>> loadedMRVers;
+    //@}
+
     /// Clean up memory
     void destroy();
 
@@ -272,6 +279,13 @@ public:
     virtual void readFile(const std::string& filename);
     virtual MRVer* getMRVERFromString(const std::string& input);
 
+    /// Binary SVFG snapshot (see SVFGReadWrite.cpp for the layout)
+    //@{
+    virtual void writeBinaryFile(const std::string& filename);
+    virtual void readBinaryFile(const std::string& filename);
+    static bool isBinaryFile(const std::string& filename);
+    //@}
+
 protected:
     /// Add indirect def-use edges of a memory region between two statements,
     //@{
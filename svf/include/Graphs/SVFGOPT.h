@@ -59,6 +59,17 @@ class SVFGOPT : public SVFG
     typedef Map<NodeID, NodeID> NodeIDToNodeIDMap;
     typedef FIFOWorkList<const MSSAPHISVFGNode*> WorkList;
 
+    /// An indirect edge computed while retargeting, added to the graph later in bulk
+    struct RetargetEdge
+    {
+        SVFGEdge::SVFGEdgeK kind;
+        NodeID src;
+        NodeID dst;
+        CallSiteID csId;
+        NodeBS pts;
+    };
+    typedef std::vector<RetargetEdge> RetargetEdgeBuffer;
+
 public:
     /// Constructor
     SVFGOPT(std::unique_ptr<MemSSA> mssa, VFGK kind) : SVFG(std::move(mssa), kind)
@@ -190,7 +201,11 @@ private:
     //@{
     /// Record def sites of actual-in/formal-out and connect from those def-sites
     /// to formal-in/actual-out directly if they exist.
-    void retargetEdgesOfAInFOut(SVFGNode* node);
+    /// The nodes are independent of each other, so new edges are computed per function
+    /// (concurrently with -svfg-opt-threads) and then added in one batch.
+    void retargetEdgesOfAInFOut(const std::vector<SVFGNode*>& nodes);
+    /// Collect the def site of an actual-in/formal-out and the edges replacing it.
+    NodeID collectRetargetEdgesOfAInFOut(const SVFGNode* node, RetargetEdgeBuffer& edges) const;
     /// Connect actual-out/formal-in's predecessors to their successors directly.
     void retargetEdgesOfAOutFIn(SVFGNode* node);
     //@}
@@ -156,6 +156,53 @@ public:
         svfgOptTimeEnd = PTAStat::getClk(true);
     }
 
+    void interOptStart()
+    {
+        interOptTimeStart = PTAStat::getClk(true);
+    }
+
+    void interOptEnd()
+    {
+        interOptTimeEnd = PTAStat::getClk(true);
+    }
+
+    void intraOptStart()
+    {
+        intraOptTimeStart = PTAStat::getClk(true);
+    }
+
+    void intraOptEnd()
+    {
+        intraOptTimeEnd = PTAStat::getClk(true);
+    }
+
+    /// Nodes removed by the inter- and intra-procedural phases of SVFGOPT
+    void setOptRemovedNodes(u32_t inter, u32_t intra)
+    {
+        numOfInterOptRemoved = inter;
+        numOfIntraOptRemoved = intra;
+    }
+
+    void readSVFGStart()
+    {
+        readSVFGTimeStart = PTAStat::getClk(true);
+    }
+
+    void readSVFGEnd()
+    {
+        readSVFGTimeEnd = PTAStat::getClk(true);
+    }
+
+    void writeSVFGStart()
+    {
+        writeSVFGTimeStart = PTAStat::getClk(true);
+    }
+
+    void writeSVFGEnd()
+    {
+        writeSVFGTimeEnd = PTAStat::getClk(true);
+    }
+
 private:
     void clear();
 
@@ -228,6 +275,21 @@ private:
     double svfgOptTimeStart;
     double svfgOptTimeEnd;
 
+    double interOptTimeStart;
+    double interOptTimeEnd;
+
+    double intraOptTimeStart;
+    double intraOptTimeEnd;
+
+    u32_t numOfInterOptRemoved;	///< nodes removed by SVFGOPT inter-procedural phase
+    u32_t numOfIntraOptRemoved;	///< nodes removed by SVFGOPT intra-procedural phase
+
+    double readSVFGTimeStart;
+    double readSVFGTimeEnd;
+
+    double writeSVFGTimeStart;
+    double writeSVFGTimeEnd;
+
     SVFGNodeSet forwardSlice;
     SVFGNodeSet backwardSlice;
     SVFGNodeSet	sources;
@@ -37,11 +37,14 @@ namespace SVF
 
 class MSSADEF;
 
+class MemSSA;
+
 /*!
  * Memory SSA Variable (in the form of SSA versions of each memory region )
  */
 class MRVer
 {
+    friend class MemSSA;
 
 public:
     typedef MSSADEF MSSADef;
@@ -59,6 +62,13 @@ public:
     {
     }
 
+    /// Constructor for a version which is given its ID later
+    /// (by MemSSA when merging per-function results)
+    MRVer(const MemRegion* m, MRVERSION v, MSSADef* d, MRVERID id) :
+        mr(m), version(v), vid(id),def(d)
+    {
+    }
+
     /// Return the memory region
     inline const MemRegion* getMR() const
     {
@@ -76,6 +76,8 @@ public:
     typedef OrderedMap<NodeBS, PointsToList> PtsToSubPtsMap;
     typedef Map<const SVFFunction*, PtsToSubPtsMap> FunToPtsMap;
     typedef Map<const SVFFunction*, PointsToList> FunToInterMap;
+    typedef Map<NodeID, const MemRegion*> ObjToMRMap;
+    typedef Map<const SVFFunction*, ObjToMRMap> FunToObjToMRMap;
 
     IntraDisjointMRG(BVDataPTAImpl* p, bool ptrOnly) : MRGenerator(p, ptrOnly)
     {}
@@ -96,11 +98,14 @@ protected:
     virtual inline void getMRsForLoad(MRSet& aliasMRs, const NodeBS& cpts,
                                       const SVFFunction* fun)
     {
-        const PointsToList& inters = getIntersList(fun);
-        getMRsForLoadFromInterList(aliasMRs, cpts, inters);
+        getMRsForLoadFromInterList(aliasMRs, cpts, getObjToMRMap(fun));
     }
 
-    void getMRsForLoadFromInterList(MRSet& mrs, const NodeBS& cpts, const PointsToList& inters);
+    /// Get the regions (of intersections indexed in objToMR) contained in cpts.
+    void getMRsForLoadFromInterList(MRSet& mrs, const NodeBS& cpts, const ObjToMRMap& objToMR);
+
+    /// Map each object in the (disjoint) intersections to the region of its intersection.
+    void indexInters(const PointsToList& inters, ObjToMRMap& objToMR) const;
 
     /// Get memory regions to be inserted at a load statement.
     virtual void getMRsForCallSiteRef(MRSet& aliasMRs, const NodeBS& cpts, const SVFFunction* fun);
@@ -122,6 +127,11 @@ private:
         return funcToInterMap[func];
     }
 
+    inline ObjToMRMap& getObjToMRMap(const SVFFunction* func)
+    {
+        return funcToObjToMRMap[func];
+    }
+
     inline const PtsToSubPtsMap& getPtsSubSetMap(const SVFFunction* func) const
     {
         FunToPtsMap::const_iterator it = funcToPtsMap.find(func);
@@ -131,6 +141,7 @@ private:
 
     FunToPtsMap funcToPtsMap;
     FunToInterMap funcToInterMap;
+    FunToObjToMRMap funcToObjToMRMap;
 };
 
 /*!
@@ -157,11 +168,12 @@ protected:
     virtual inline void getMRsForLoad(MRSet& aliasMRs, const NodeBS& cpts,
                                       const SVFFunction*)
     {
-        getMRsForLoadFromInterList(aliasMRs, cpts, inters);
+        getMRsForLoadFromInterList(aliasMRs, cpts, objToMR);
     }
 
 private:
     PointsToList inters;
+    ObjToMRMap objToMR;
 };
 
 } // End namespace SVF
@@ -144,6 +144,7 @@ public:
     typedef Map<const SVFFunction*, NodeBS> FunToPointsToMap;
     typedef Map<const SVFFunction*, PointsToList> FunToPointsTosMap;
     typedef OrderedMap<NodeBS, NodeBS, SVFUtil::equalNodeBS> PtsToRepPtsSetMap;
+    typedef Map<NodeBS, const MemRegion*> PtsToMRMap;
 
     /// Map a function to its region set
     typedef Map<const SVFFunction*, MRSet> FunToMRsMap;
@@ -276,12 +277,21 @@ protected:
 
     /// A set of All memory regions
     MRSet memRegSet;
+    /// Map the points-to set of each region in memRegSet to the region (hashed lookups)
+    PtsToMRMap cptsToMRMap;
     /// Map a condition pts to its rep conditional pts (super set points-to)
     PtsToRepPtsSetMap cptsToRepCPtsMap;
 
     /// Generate a memory region and put in into functions which use it
     void createMR(const SVFFunction* fun, const NodeBS& cpts);
 
+    /// Return the memory region whose points-to set is exactly cpts, nullptr if there is none
+    inline const MemRegion* findMR(const NodeBS& cpts) const
+    {
+        PtsToMRMap::const_iterator it = cptsToMRMap.find(cpts);
+        return it == cptsToMRMap.end() ? nullptr : it->second;
+    }
+
     /// Collect all global variables for later escape analysis
     void collectGlobals();
 
@@ -156,6 +156,19 @@ private:
 
     std::vector<std::unique_ptr<MRVer>> usedMRVers;
 
+    /// Whether this builds a single function for buildMemSSAInParallel
+    /// (sharing pta, mrGen, and stat with the MemSSA it is merged into).
+    bool funWorker;
+
+    /// Constructor of a per-function worker
+    explicit MemSSA(const MemSSA* parent);
+
+    /// Build memory SSA for fun, adding the time of each phase to the given counters
+    void buildMemSSA(const SVFFunction& fun, double& muchiTime, double& phiTime, double& renameTime);
+
+    /// Move the mus/chis/phis and versions built by a per-function worker into this
+    void mergeFunMSSA(MemSSA& funMSSA);
+
     /// Release the memory
     void destroy();
 
@@ -317,6 +330,9 @@ public:
     /// We start from here
     virtual void buildMemSSA(const SVFFunction& fun);
 
+    /// Build memory SSA for funs with Options::MSSAThreads threads, one function at a time per thread
+    void buildMemSSAInParallel(const std::vector<const SVFFunction*>& funs);
+
     /// Perform statistics
     void performStat();
 
@@ -55,6 +55,8 @@
 
 #include "SVFIR/SVFType.h"
 
+#include <functional>
+
 namespace SVF
 {
 /// Basic points-to data structure
@@ -244,6 +246,15 @@ public:
     virtual bool updateATVPts(const Key& srcVar, LocID dstLoc, const Key& dstVar) = 0;
     ///@}
 
+    /// Dump and restore IN/OUT sets (used for checkpointing).
+    ///@{
+    typedef std::function<void(LocID, const Key&, const DataSet&)> DFPtsVisitor;
+    /// Calls visit on every (loc, var, pts) in the IN sets if in is true, OUT sets otherwise.
+    virtual void visitDFPts(bool in, const DFPtsVisitor& visit) = 0;
+    /// Union (IN[loc:var], pts) if in is true, (OUT[loc:var], pts) otherwise.
+    virtual bool unionDFPts(bool in, LocID loc, const Key& var, const DataSet& pts) = 0;
+    ///@}
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const DFPTData<Key, KeySet, Data, DataSet> *)
@@ -580,6 +580,22 @@ public:
         return allPts;
     }
 
+    virtual void visitDFPts(bool in, const typename BaseDFPTData::DFPtsVisitor& visit) override
+    {
+        for (const typename DFPtsMap::value_type &lopt : in ? dfInPtsMap : dfOutPtsMap)
+        {
+            for (const typename PtsMap::value_type &opt : lopt.second)
+            {
+                if (!opt.second.empty()) visit(lopt.first, opt.first, opt.second);
+            }
+        }
+    }
+
+    virtual bool unionDFPts(bool in, LocID loc, const Key& var, const DataSet& pts) override
+    {
+        return unionPts(in ? getDFInPtsSet(loc, var) : getDFOutPtsSet(loc, var), pts);
+    }
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const MutableDFPTData<Key, KeySet, Data, DataSet> *)
@@ -813,6 +829,15 @@ public:
         }
     }
 
+    /// Restored sets are marked as updated so they are propagated again.
+    virtual bool unionDFPts(bool in, LocID loc, const Key& var, const DataSet& pts) override
+    {
+        if (!BaseMutDFPTData::unionDFPts(in, loc, var, pts)) return false;
+        if (in) setVarDFInSetUpdated(loc, var);
+        else setVarDFOutSetUpdated(loc, var);
+        return true;
+    }
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const MutableIncDFPTData<Key, KeySet, Data, DataSet> *)
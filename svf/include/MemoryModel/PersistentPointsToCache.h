@@ -60,6 +60,9 @@ public:
         unionCache.clear();
         complementCache.clear();
         intersectionCache.clear();
+
+        freeIds.clear();
+        liveMarks.clear();
     }
 
     /// Resets the cache removing everything except the emptyData it was initialised with.
@@ -79,11 +82,17 @@ public:
     /// Remaps all points-to sets stored in the cache to the current mapping.
     void remapAllPts(void)
     {
-        for (auto &d : idToPts) d->checkAndRemap();
+        for (auto &d : idToPts)
+        {
+            if (d != nullptr) d->checkAndRemap();
+        }
 
         // Rebuild ptsToId from idToPts.
         ptsToId.clear();
-        for (PointsToID i = 0; i < idToPts.size(); ++i) ptsToId[*idToPts[i]] = i;
+        for (PointsToID i = 0; i < idToPts.size(); ++i)
+        {
+            if (idToPts[i] != nullptr) ptsToId[*idToPts[i]] = i;
+        }
     }
 
     /// If pts is not in the PersistentPointsToCache, inserts it, assigns an ID, and returns
@@ -95,18 +104,14 @@ public:
         if (foundId != ptsToId.end()) return foundId->second;
 
         // Otherwise, insert it.
-        PointsToID id = newPointsToId();
-        idToPts.push_back(std::make_unique<Data>(pts));
-        ptsToId[pts] = id;
-
-        return id;
+        return internPts(pts);
     }
 
     /// Returns the points-to set which id represents. id must be stored in the cache.
     const Data &getActualPts(PointsToID id) const
     {
         // Check if the points-to set for ID has already been stored.
-        assert(idToPts.size() > id && "PPTC::getActualPts: points-to set not stored!");
+        assert(idToPts.size() > id && idToPts[id] != nullptr && "PPTC::getActualPts: points-to set not stored!");
         return *idToPts.at(id);
     }
 
@@ -315,7 +320,7 @@ public:
         static const unsigned fieldWidth = 25;
         SVFUtil::outs().flags(std::ios::left);
 
-        SVFUtil::outs() << std::setw(fieldWidth) << "UniquePointsToSets"      << idToPts.size()          << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "UniquePointsToSets"      << idToPts.size() - freeIds.size() << "\n";
 
         SVFUtil::outs() << std::setw(fieldWidth) << "TotalUnions"             << totalUnions             << "\n";
         SVFUtil::outs() << std::setw(fieldWidth) << "PropertyUnions"          << propertyUnions          << "\n";
@@ -335,6 +340,14 @@ public:
         SVFUtil::outs() << std::setw(fieldWidth) << "LookupIntersections"     << lookupIntersections     << "\n";
         SVFUtil::outs() << std::setw(fieldWidth) << "PreemptiveIntersections" << preemptiveIntersections << "\n";
 
+        if (totalSweeps != 0)
+        {
+            SVFUtil::outs() << std::setw(fieldWidth) << "Sweeps"                  << totalSweeps             << "\n";
+            SVFUtil::outs() << std::setw(fieldWidth) << "ReclaimedPointsToSets"   << reclaimedPts            << "\n";
+            SVFUtil::outs() << std::setw(fieldWidth) << "ReclaimedElements"       << reclaimedElements       << "\n";
+            SVFUtil::outs() << std::setw(fieldWidth) << "TrimmedOpCacheEntries"   << trimmedOpCacheEntries   << "\n";
+        }
+
         SVFUtil::outs().flush();
     }
 
@@ -345,11 +358,59 @@ public:
     Map<Data, unsigned> getAllPts(void)
     {
         Map<Data, unsigned> allPts;
-        for (const auto &d : idToPts) allPts[*d] = 1;
+        for (const auto &d : idToPts)
+        {
+            if (d != nullptr) allPts[*d] = 1;
+        }
+
         return allPts;
     }
 
-    // TODO: ref count API for garbage collection.
+    /// Garbage collection is epoch based: users mark every ID they still hold
+    /// through markLive, then sweep frees everything else. IDs handed out before
+    /// a sweep and not marked must not be used afterwards, as they may be reused.
+    ///@{
+    /// Marks id as reachable for the next sweep.
+    inline void markLive(PointsToID id)
+    {
+        if (id >= liveMarks.size()) liveMarks.resize(idToPts.size(), false);
+        liveMarks[id] = true;
+    }
+
+    /// Frees every points-to set not marked since the last sweep, making its ID
+    /// available again, and trims op cache entries mentioning any of them.
+    /// Returns the number of points-to sets reclaimed.
+    u64_t sweep(void)
+    {
+        liveMarks.resize(idToPts.size(), false);
+        liveMarks[emptyPointsToId()] = true;
+
+        u64_t reclaimed = 0;
+        for (PointsToID id = 0; id < idToPts.size(); ++id)
+        {
+            if (liveMarks[id] || idToPts[id] == nullptr) continue;
+
+            reclaimedElements += idToPts[id]->count();
+            ptsToId.erase(*idToPts[id]);
+            idToPts[id].reset();
+            freeIds.push_back(id);
+            ++reclaimed;
+        }
+
+        if (reclaimed != 0)
+        {
+            trimmedOpCacheEntries += trimOpCache(unionCache);
+            trimmedOpCacheEntries += trimOpCache(complementCache);
+            trimmedOpCacheEntries += trimOpCache(intersectionCache);
+        }
+
+        liveMarks.clear();
+
+        ++totalSweeps;
+        reclaimedPts += reclaimed;
+        return reclaimed;
+    }
+    ///@}
 
 private:
     PointsToID newPointsToId(void)
@@ -359,6 +420,44 @@ private:
         return idCounter++;
     }
 
+    /// Stores pts (which must not already be stored) under a fresh or reclaimed ID.
+    PointsToID internPts(const Data &pts)
+    {
+        PointsToID id;
+        if (!freeIds.empty())
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+            idToPts[id] = std::make_unique<Data>(pts);
+        }
+        else
+        {
+            id = newPointsToId();
+            idToPts.push_back(std::make_unique<Data>(pts));
+        }
+
+        ptsToId[pts] = id;
+        return id;
+    }
+
+    /// Removes any entry of opCache whose operands or result were not marked
+    /// live. Returns the number of entries removed.
+    u64_t trimOpCache(OpCache &opCache)
+    {
+        u64_t trimmed = 0;
+        for (OpCache::iterator it = opCache.begin(); it != opCache.end();)
+        {
+            if (!liveMarks[it->first.first] || !liveMarks[it->first.second] || !liveMarks[it->second])
+            {
+                it = opCache.erase(it);
+                ++trimmed;
+            }
+            else ++it;
+        }
+
+        return trimmed;
+    }
+
     /// Performs dataOp on lhs and rhs, checking the opCache first and updating it afterwards.
     /// commutative indicates whether the operation in question is commutative or not.
     /// opPerformed is set to true if the operation was *not* cached and thus performed, false otherwise.
@@ -386,12 +485,7 @@ private:
         // Intern points-to set: check if result already exists.
         typename PTSToIDMap::const_iterator foundId = ptsToId.find(result);
         if (foundId != ptsToId.end()) resultId = foundId->second;
-        else
-        {
-            resultId = newPointsToId();
-            idToPts.push_back(std::make_unique<Data>(result));
-            ptsToId[result] = resultId;
-        }
+        else resultId = internPts(result);
 
         // Cache the result, for hash-consing.
         opCache[operands] = resultId;
@@ -418,13 +512,17 @@ private:
         propertyIntersections    = 0;
         lookupIntersections      = 0;
         preemptiveIntersections  = 0;
+        totalSweeps              = 0;
+        reclaimedPts             = 0;
+        reclaimedElements        = 0;
+        trimmedOpCacheEntries    = 0;
     }
 
 private:
     /// Maps points-to IDs (indices) to their corresponding points-to set.
     /// Reverse of idToPts.
     /// Elements are only added through push_back, so the number of elements
-    /// stored is the size of the vector.
+    /// stored is the size of the vector less the swept (null) entries in freeIds.
     /// Not const so we can remap.
     std::vector<std::unique_ptr<Data>> idToPts;
     /// Maps points-to sets to their corresponding ID.
@@ -440,6 +538,11 @@ private:
     /// Used to generate new PointsToIDs. Any non-zero is valid.
     PointsToID idCounter;
 
+    /// IDs freed by sweep, to be handed out before generating new ones.
+    std::vector<PointsToID> freeIds;
+    /// liveMarks[id] is true if id has been marked live in the current epoch.
+    std::vector<bool> liveMarks;
+
     // Statistics:
     u64_t totalUnions;
     u64_t uniqueUnions;
@@ -456,6 +559,10 @@ private:
     u64_t propertyIntersections;
     u64_t lookupIntersections;
     u64_t preemptiveIntersections;
+    u64_t totalSweeps;
+    u64_t reclaimedPts;
+    u64_t reclaimedElements;
+    u64_t trimmedOpCacheEntries;
 };
 
 } // End namespace SVF
@@ -56,10 +56,13 @@ public:
         revPtsMap.clear();
     }
 
+    /// Does not insert var, so concurrent lookups into finished points-to data are safe
     inline const DataSet& getPts(const Key &var) override
     {
-        PointsToID id = ptsMap[var];
-        return ptCache.getActualPts(id);
+        typename KeyToIDMap::const_iterator it = ptsMap.find(var);
+        if (it == ptsMap.end())
+            return ptCache.getActualPts(PersistentPointsToCache<DataSet>::emptyPointsToId());
+        return ptCache.getActualPts(it->second);
     }
 
     inline const KeySet& getRevPts(const Data &data) override
@@ -117,6 +120,12 @@ public:
         ptCache.remapAllPts();
     }
 
+    /// Marks every points-to ID held as live in ptCache (for its next sweep).
+    void markLivePts(void) const
+    {
+        for (const typename KeyToIDMap::value_type &ki : ptsMap) ptCache.markLive(ki.second);
+    }
+
     Map<DataSet, unsigned> getAllPts(bool liveOnly) const override
     {
         Map<DataSet, unsigned> allPts;
@@ -301,6 +310,14 @@ public:
         propaPtsMap[var] = ptCache.emptyPointsToId();
     }
 
+    /// Marks every points-to ID held as live in ptCache (for its next sweep).
+    void markLivePts(void) const
+    {
+        persPTData.markLivePts();
+        for (const typename KeyToIDMap::value_type &ki : diffPtsMap) ptCache.markLive(ki.second);
+        for (const typename KeyToIDMap::value_type &ki : propaPtsMap) ptCache.markLive(ki.second);
+    }
+
     Map<DataSet, unsigned> getAllPts(bool liveOnly) const override
     {
         return persPTData.getAllPts(liveOnly);
@@ -498,6 +515,21 @@ public:
         return unionPtsThroughIds(getDFOutPtIdRef(dstLoc, dstVar), persPTData.ptsMap[srcVar]);
     }
 
+    /// Marks every points-to ID held (top-level, IN, and OUT) as live in ptCache
+    /// (for its next sweep). Intermediate IN/OUT sets which have since been
+    /// replaced are what a sweep reclaims.
+    void markLivePts(void) const
+    {
+        persPTData.markLivePts();
+        for (const DFKeyToIDMap *dfPtsMap : { &dfInPtsMap, &dfOutPtsMap })
+        {
+            for (const typename DFKeyToIDMap::value_type &lki : *dfPtsMap)
+            {
+                for (const typename KeyToIDMap::value_type &ki : lki.second) ptCache.markLive(ki.second);
+            }
+        }
+    }
+
     Map<DataSet, unsigned> getAllPts(bool liveOnly) const override
     {
         Map<DataSet, unsigned> allPts = persPTData.getAllPts(liveOnly);
@@ -531,6 +563,24 @@ public:
         return allPts;
     }
 
+    void visitDFPts(bool in, const typename BaseDFPTData::DFPtsVisitor& visit) override
+    {
+        for (const typename DFKeyToIDMap::value_type &lki : in ? dfInPtsMap : dfOutPtsMap)
+        {
+            for (const typename KeyToIDMap::value_type &ki : lki.second)
+            {
+                const DataSet &pts = ptCache.getActualPts(ki.second);
+                if (!pts.empty()) visit(lki.first, ki.first, pts);
+            }
+        }
+    }
+
+    bool unionDFPts(bool in, LocID loc, const Key& var, const DataSet& pts) override
+    {
+        PointsToID srcId = ptCache.emplacePts(pts);
+        return unionPtsThroughIds(in ? getDFInPtIdRef(loc, var) : getDFOutPtIdRef(loc, var), srcId);
+    }
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const PersistentDFPTData<Key, KeySet, Data, DataSet> *)
@@ -716,6 +766,15 @@ public:
         BasePersDFPTData::clear();
     }
 
+    /// Restored sets are marked as updated so they are propagated again.
+    bool unionDFPts(bool in, LocID loc, const Key& var, const DataSet& pts) override
+    {
+        if (!BasePersDFPTData::unionDFPts(in, loc, var, pts)) return false;
+        if (in) setVarDFInSetUpdated(loc, var);
+        else setVarDFOutSetUpdated(loc, var);
+        return true;
+    }
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const PersistentIncDFPTData<Key, KeySet, Data, DataSet> *)
@@ -901,6 +960,14 @@ public:
         tlPTData.remapAllPts();
     }
 
+    /// Marks every points-to ID held (top-level and versioned) as live in the
+    /// shared cache (for its next sweep).
+    void markLivePts(void) const
+    {
+        tlPTData.markLivePts();
+        atPTData.markLivePts();
+    }
+
     Map<DataSet, unsigned> getAllPts(bool liveOnly) const override
     {
         // Explicitly pass in true because if we call it with false,
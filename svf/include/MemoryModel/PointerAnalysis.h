@@ -340,7 +340,8 @@ public:
     inline void setObjFieldInsensitive(NodeID id)
     {
         MemObj* mem =  const_cast<MemObj*>(pag->getBaseObj(id));
-        mem->setFieldInsensitive();
+        if (!mem->isFieldInsensitive())
+            mem->setFieldInsensitive();
     }
     inline bool isFieldInsensitive(NodeID id) const
     {
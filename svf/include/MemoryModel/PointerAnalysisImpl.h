@@ -138,10 +138,15 @@ public:
     /// Remap all points-to sets to use the current mapping.
     void remapPointsToSets(void);
 
+    /// Frees the persistent points-to sets which the points-to data no longer
+    /// refers to. Returns how many were freed (always 0 for mutable backings).
+    u64_t sweepPtCache(void);
+
     /// Interface for analysis result storage on filesystem.
     //@{
     virtual void writeToFile(const std::string& filename);
     virtual void writeObjVarToFile(const std::string& filename);
+    virtual void writeObjFieldSensitivityToFile(std::fstream& f);
     virtual void writePtsResultToFile(std::fstream& f);
     virtual void writeGepObjVarMapToFile(std::fstream& f);
     virtual bool readFromFile(const std::string& filename);
@@ -42,6 +42,7 @@
 #include "Graphs/SVFG.h"
 #include "Util/DPItem.h"
 #include "Util/SVFBugReport.h"
+#include <chrono>
 
 namespace SVF
 {
@@ -60,11 +61,22 @@ public:
 
     typedef SaberCondAllocator::SVFGNodeToSVFGNodeSetMap SVFGNodeToSVFGNodeSetMap;
 
+    /// The budget whose exhaustion made the result of a slice unknown
+    enum BudgetKind
+    {
+        NoBudget,		///< within all budgets
+        NodeBudget,		///< visited SVFG nodes during traversal
+        GuardBudget,	///< value-flow guards computed during guard computation
+        TimeBudget		///< wall-clock time
+    };
+
 
     /// Constructor
     ProgSlice(const SVFGNode* src, SaberCondAllocator* pa, const SVFG* graph):
         root(src), partialReachable(false), fullReachable(false), reachGlob(false),
-        pathAllocator(pa), _curSVFGNode(nullptr), finalCond(pa->getFalseCond()), svfg(graph)
+        pathAllocator(pa), _curSVFGNode(nullptr), finalCond(pa->getFalseCond()), svfg(graph),
+        maxNodes(0), maxGuards(0), maxTime(0), numOfVisitedNodes(0), numOfGuards(0),
+        elapsedTime(0), timerRunning(false), exhaustedBudget(NoBudget)
     {
     }
 
@@ -166,11 +178,85 @@ public:
     }
     //@}
 
+    /// Per-slice budgets
+    //@{
+    /// Set the budgets of this slice, 0 means unlimited
+    inline void setBudget(u32_t nodes, u32_t guards, double seconds)
+    {
+        maxNodes = nodes;
+        maxGuards = guards;
+        maxTime = seconds;
+    }
+    /// Only time between resumeTimer and pauseTimer counts, e.g., not waiting for other slices
+    inline void resumeTimer()
+    {
+        timerStart = std::chrono::steady_clock::now();
+        timerRunning = true;
+    }
+    inline void pauseTimer()
+    {
+        if (timerRunning)
+            elapsedTime = getElapsedTime();
+        timerRunning = false;
+    }
+    /// Wall-clock seconds spent on this slice
+    inline double getElapsedTime() const
+    {
+        if (!timerRunning)
+            return elapsedTime;
+        std::chrono::duration<double> d = std::chrono::steady_clock::now() - timerStart;
+        return elapsedTime + d.count();
+    }
+    /// Count a visited node, return false once some budget is exhausted
+    inline bool chargeNode()
+    {
+        if (++numOfVisitedNodes > maxNodes && maxNodes)
+            setBudgetExhausted(NodeBudget);
+        return chargeTime(numOfVisitedNodes);
+    }
+    /// Count a number of visited nodes at once, return false once some budget is exhausted
+    inline bool chargeNodes(u32_t num)
+    {
+        numOfVisitedNodes += num;
+        if (numOfVisitedNodes > maxNodes && maxNodes)
+            setBudgetExhausted(NodeBudget);
+        return chargeTime(0);
+    }
+    /// Count a computed value-flow guard, return false once some budget is exhausted
+    inline bool chargeGuard()
+    {
+        if (++numOfGuards > maxGuards && maxGuards)
+            setBudgetExhausted(GuardBudget);
+        return chargeTime(numOfGuards);
+    }
+    inline bool isBudgetExhausted() const
+    {
+        return exhaustedBudget != NoBudget;
+    }
+    inline BudgetKind getExhaustedBudget() const
+    {
+        return exhaustedBudget;
+    }
+    inline u32_t getNumOfVisitedNodes() const
+    {
+        return numOfVisitedNodes;
+    }
+    inline u32_t getNumOfGuards() const
+    {
+        return numOfGuards;
+    }
+    static std::string getBudgetName(BudgetKind kind);
+    //@}
+
     /// Guarded reachability solve
     bool AllPathReachableSolve();
     bool isSatisfiableForAll();
     bool isSatisfiableForPairs();
 
+    /// Hand a solved slice over to another allocator, translating the conditions left for reporting
+    /// (the final condition and those of sinks) into the current z3 context and dropping the others
+    void moveToAllocator(SaberCondAllocator* pa);
+
     /// Get callsite ID and get returnsiteID from SVFGEdge
     //@{
     const CallICFGNode* getCallSite(const SVFGEdge* edge) const;
@@ -302,6 +388,19 @@ protected:
     /// Compute invalid branch condition stemming from removed strong update value-flow edges
     Condition computeInvalidCondFromRemovedSUVFEdge(const SVFGNode * cur);
 
+    inline void setBudgetExhausted(BudgetKind kind)
+    {
+        if (exhaustedBudget == NoBudget)
+            exhaustedBudget = kind;
+    }
+    /// Check the time budget every 64 charges, the clock is not free
+    inline bool chargeTime(u32_t charges)
+    {
+        if (maxTime > 0 && (charges & 63) == 0 && getElapsedTime() > maxTime)
+            setBudgetExhausted(TimeBudget);
+        return exhaustedBudget == NoBudget;
+    }
+
     const SVFGNodeToSVFGNodeSetMap& getRemovedSUVFEdges() const
     {
         return pathAllocator->getRemovedSUVFEdges();
@@ -320,6 +419,15 @@ private:
     const SVFGNode* _curSVFGNode;			///<  current svfg node during guard computation
     Condition finalCond;					///<  final condition
     const SVFG* svfg;						///<  SVFG
+    u32_t maxNodes;							///<  node budget, 0 if unlimited
+    u32_t maxGuards;						///<  guard budget, 0 if unlimited
+    double maxTime;							///<  time budget in seconds, 0 if unlimited
+    u32_t numOfVisitedNodes;				///<  nodes visited by the traversals
+    u32_t numOfGuards;						///<  value-flow guards computed
+    double elapsedTime;						///<  seconds spent before the timer was last resumed
+    std::chrono::steady_clock::time_point timerStart;
+    bool timerRunning;
+    BudgetKind exhaustedBudget;				///<  the first exhausted budget
 };
 
 } // End namespace SVF
@@ -34,7 +34,7 @@
 #include "SVFIR/SVFValue.h"
 #include "Util/WorkList.h"
 #include "Graphs/SVFG.h"
-#include "Util/Z3Expr.h"
+#include "SABER/SaberCondition.h"
 
 
 namespace SVF
@@ -48,7 +48,7 @@ class SaberCondAllocator
 
 public:
 
-    typedef Z3Expr Condition;   /// z3 condition
+    typedef SaberCondition Condition;   /// z3 or BDD condition
     typedef Map<u32_t, const ICFGNode*> IndexToTermInstMap; /// id to instruction map for z3
     typedef Map<u32_t,Condition> CondPosMap;		///< map a branch to its Condition
     typedef Map<const SVFBasicBlock*, CondPosMap > BBCondMap;	/// map bb to a Condition
@@ -57,6 +57,7 @@ public:
     typedef Map<const SVFBasicBlock*, Condition> BBToCondMap;	///< map a basic block to its condition during control-flow guard computation
     typedef FIFOWorkList<const SVFBasicBlock*> CFWorkList;	///< worklist for control-flow guard computation
     typedef Map<const SVFGNode*, Set<const SVFGNode*>> SVFGNodeToSVFGNodeSetMap;
+    typedef Map<const SVFGEdge*, Condition> SVFGEdgeToCondMap;	///< map a value-flow edge to its guard
 
 
     /// Constructor
@@ -80,8 +81,26 @@ public:
     {
         return totalCondNum;
     }
+    inline u32_t getNumOfVFGuards() const
+    {
+        return edgeToVFGuard.size() + numOfThreadVFGuards;
+    }
+    inline u32_t getNumOfVFGuardHits() const
+    {
+        return numOfVFGuardHits;
+    }
+    /// Add the guard statistics of an allocator created by newThreadAllocator
+    inline void addThreadVFGuardStat(const SaberCondAllocator& allocator)
+    {
+        numOfVFGuardHits += allocator.getNumOfVFGuardHits();
+        numOfThreadVFGuards += allocator.getNumOfVFGuards();
+    }
     //@}
 
+    /// Allocator computing guards in the z3 context of the calling thread (Z3Expr::newThreadContext)
+    /// from the branch conditions of this one, translated into it. Its guard cache is its own.
+    SaberCondAllocator* newThreadAllocator() const;
+
     /// Condition operations
     //@{
     inline Condition condAnd(const Condition& lhs, const Condition& rhs)
@@ -123,7 +142,7 @@ public:
     /// Perform path allocation
     void allocate(const SVFModule* module);
 
-    /// Get/Set instruction based on Z3 expression id
+    /// Get/Set instruction based on condition id
     //{@
     inline const ICFGNode* getCondInst(u32_t id) const
     {
@@ -170,6 +189,24 @@ public:
     virtual Condition ComputeInterCallVFGGuard(const SVFBasicBlock* src, const SVFBasicBlock* dst, const SVFBasicBlock* callBB);
     virtual Condition ComputeInterRetVFGGuard(const SVFBasicBlock* src, const SVFBasicBlock* dst, const SVFBasicBlock* retBB);
 
+    /// Guards of value-flow edges computed by earlier slices. The guard of an edge only depends on
+    /// the basic blocks of its endpoints, hence it is shared by the slices of all sources
+    //@{
+    inline bool getCachedVFGuard(const SVFGEdge* edge, Condition& cond)
+    {
+        SVFGEdgeToCondMap::const_iterator it = edgeToVFGuard.find(edge);
+        if (it == edgeToVFGuard.end())
+            return false;
+        numOfVFGuardHits++;
+        cond = it->second;
+        return true;
+    }
+    inline void cacheVFGuard(const SVFGEdge* edge, const Condition& cond)
+    {
+        edgeToVFGuard[edge] = cond;
+    }
+    //@}
+
     /// Get complement condition (from B1 to B0) according to a complementBB (BB2) at a phi
     /// e.g., B0: dstBB; B1:incomingBB; B2:complementBB
     virtual Condition getPHIComplementCond(const SVFBasicBlock* BB1, const SVFBasicBlock* BB2, const SVFBasicBlock* BB0);
@@ -295,7 +332,7 @@ private:
 
     }
 
-    /// extract subexpression from a Z3 expression
+    /// extract branch conditions from a condition
     void extractSubConds(const Condition &condition, NodeBS &support) const;
 
 
@@ -305,8 +342,12 @@ private:
     IndexToTermInstMap idToTermInstMap;     ///key: z3 expression id, value: instruction
     NodeBS negConds;                        ///bit vector for distinguish neg
     std::vector<Condition> conditionVec;          /// vector storing z3expression
+    Map<u32_t, u32_t> bddVarToCondIdx;      ///< BDD variable to the index of its positive literal in conditionVec
     static u32_t totalCondNum; /// a counter for fresh condition
     SVFGNodeToSVFGNodeSetMap removedSUVFEdges;
+    SVFGEdgeToCondMap edgeToVFGuard;		///< guards of value-flow edges shared by all slices
+    u32_t numOfVFGuardHits = 0;
+    u32_t numOfThreadVFGuards = 0;		///< guards cached by allocators of threads
 
 protected:
     BBCondMap bbConds;						///< map basic block to its successors/predecessors branch conditions
@@ -0,0 +1,157 @@
+//===- SaberCondition.h -- Path conditions of SABER---------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * SaberCondition.h
+ *
+ * A path condition of SABER, a Boolean combination of branch variables. It is
+ * either a Z3 expression or a BDD, chosen once for all conditions by
+ * Options::SaberBDD() when the SaberCondAllocator is created.
+ */
+
+#ifndef SABERCONDITION_H_
+#define SABERCONDITION_H_
+
+#include "Util/Z3Expr.h"
+#include "Util/BDDExpr.h"
+
+namespace SVF
+{
+
+class SaberCondition
+{
+public:
+    /// Whether conditions are BDDs rather than Z3 expressions
+    static bool useBDD;
+
+private:
+    z3::expr e;		///< the condition if !useBDD
+    BDDExpr bdd;	///< the condition if useBDD
+
+public:
+    SaberCondition() : e(useBDD ? z3::expr(Z3Expr::getContext()) : Z3Expr::nullExpr())
+    {
+    }
+
+    SaberCondition(const z3::expr& _e) : e(_e)
+    {
+    }
+
+    SaberCondition(const Z3Expr& z3Expr) : e(z3Expr.getExpr())
+    {
+    }
+
+    SaberCondition(const BDDExpr& _bdd) : e(Z3Expr::getContext()), bdd(_bdd)
+    {
+    }
+
+    /// The Z3 expression, only valid if !useBDD
+    inline const z3::expr& getExpr() const
+    {
+        return e;
+    }
+
+    /// The BDD, only valid if useBDD
+    inline const BDDExpr& getBDD() const
+    {
+        return bdd;
+    }
+
+    /// get id
+    inline u32_t id() const
+    {
+        return useBDD ? bdd.id() : e.id();
+    }
+
+    friend bool eq(const SaberCondition& lhs, const SaberCondition& rhs)
+    {
+        if (useBDD)
+            return eq(lhs.bdd, rhs.bdd);
+        return eq(Z3Expr(lhs.e), Z3Expr(rhs.e));
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const SaberCondition& cond)
+    {
+        out << dumpStr(cond);
+        return out;
+    }
+
+    /// output the condition as a string
+    static inline std::string dumpStr(const SaberCondition& cond)
+    {
+        if (useBDD)
+            return BDDExpr::dumpStr(cond.bdd);
+        return Z3Expr::dumpStr(cond.e);
+    }
+
+    /// Return the unique true condition
+    static inline SaberCondition getTrueCond()
+    {
+        if (useBDD)
+            return BDDExpr::getTrueCond();
+        return Z3Expr::getTrueCond();
+    }
+
+    /// Return the unique false condition
+    static inline SaberCondition getFalseCond()
+    {
+        if (useBDD)
+            return BDDExpr::getFalseCond();
+        return Z3Expr::getFalseCond();
+    }
+
+    /// null expression
+    static inline SaberCondition nullExpr()
+    {
+        if (useBDD)
+            return BDDExpr::nullExpr();
+        return Z3Expr::nullExpr();
+    }
+
+    /// compute NEG
+    static inline SaberCondition NEG(const SaberCondition& cond)
+    {
+        if (useBDD)
+            return BDDExpr::NEG(cond.bdd);
+        return Z3Expr::NEG(cond.e);
+    }
+
+    /// compute AND, used for branch condition
+    static inline SaberCondition AND(const SaberCondition& lhs, const SaberCondition& rhs)
+    {
+        if (useBDD)
+            return BDDExpr::AND(lhs.bdd, rhs.bdd);
+        return Z3Expr::AND(lhs.e, rhs.e);
+    }
+
+    /// compute OR, used for branch condition
+    static inline SaberCondition OR(const SaberCondition& lhs, const SaberCondition& rhs)
+    {
+        if (useBDD)
+            return BDDExpr::OR(lhs.bdd, rhs.bdd);
+        return Z3Expr::OR(lhs.e, rhs.e);
+    }
+};
+
+} // End namespace SVF
+
+#endif /* SABERCONDITION_H_ */
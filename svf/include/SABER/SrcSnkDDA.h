@@ -42,6 +42,9 @@
 #include "SABER/ProgSlice.h"
 #include "SABER/SaberSVFGBuilder.h"
 #include "Util/GraphReachSolver.h"
+#include "Util/Options.h"
+#include <atomic>
+#include <mutex>
 #include "Util/SVFBugReport.h"
 
 namespace SVF
@@ -67,12 +70,54 @@ public:
     typedef ProgSlice::VFWorkList WorkList;
 
 private:
-    ProgSlice* _curSlice;		/// current program slice
+    /// Traversal state of the slice being analysed; each worker of the parallel mode owns one
+    struct SliceState
+    {
+        ProgSlice* slice = nullptr;		///< current program slice
+        SVFGNodeToDPItemsMap nodeToDPItemsMap;	///<  record forward visited dpitems
+        Map<ContextCond, NodeBS> cxtToProcessedNodes;	///< nodes processed by region traversal in each context
+        SVFGNodeSet visitedSet;	///<  record backward visited nodes
+        CFLSrcSnkSolver::WorkList worklist;
+        std::unique_ptr<SaberCondAllocator> allocator;	///< allocator in the worker's own z3 context, nullptr if shared
+    };
+    mutable SliceState mainState;		///< state of the sequential analysis
+    static thread_local SliceState* workerState;	///< state of the calling worker, nullptr outside workers
     SVFGNodeSet sources;		/// source nodes
     SVFGNodeSet sinks;		/// source nodes
     std::unique_ptr<SaberCondAllocator> saberCondAllocator;
-    SVFGNodeToDPItemsMap nodeToDPItemsMap;	///<  record forward visited dpitems
-    SVFGNodeSet visitedSet;	///<  record backward visited nodes
+
+    inline SliceState& curState() const
+    {
+        return workerState ? *workerState : mainState;
+    }
+
+    NodeBS sinkReachableNodes;		///< SVFG nodes from which some sink is reachable
+    bool sinkReachBuilt;			///< whether sinkReachableNodes has been computed
+    double sinkReachTime;			///< time to compute sinkReachableNodes
+    std::atomic<u32_t> numOfPrunedSources;	///< sources reaching no sink, whose traversal was skipped
+
+    /// An SCC of the SVFG over edges other than calls and returns, which keep the context of a
+    /// traversal, summarised by every node it reaches along such edges, the sinks among them and
+    /// the nodes among them with call or return edges leaving. Regions are computed once and shared
+    /// by the forward traversals of all sources.
+    struct SliceRegion
+    {
+        NodeBS reach;
+        NodeBS sinks;
+        NodeBS interSrcs;
+    };
+    Map<NodeID, const SliceRegion*> nodeToRegion;	///< region of every node whose SCC has been computed
+    std::vector<std::unique_ptr<SliceRegion>> regions;
+    std::mutex regionMutex;			///< regions are shared by the workers of the parallel mode
+    std::atomic<u64_t> numOfRegionVisits;	///< traversals entering a region
+    std::atomic<u64_t> numOfRegionNodes;	///< nodes added to slices through regions
+
+    /// Per-source cost, recorded when a slice is reported
+    //@{
+    std::vector<u32_t> nodeCostHist;	///< number of slices by log2 of visited nodes
+    std::vector<u32_t> timeCostHist;	///< number of slices by log2 of milliseconds
+    std::vector<std::pair<const SVFGNode*, ProgSlice::BudgetKind>> unknownSources;	///< sources whose budget was exhausted
+    //@}
 
     // SVFGNodeSet visitedSet2;	///<  record foward visited nodes
 
@@ -85,7 +130,8 @@ protected:
 public:
 
     /// Constructor
-    SrcSnkDDA() : _curSlice(nullptr), svfg(nullptr), callgraph(nullptr)
+    SrcSnkDDA() : sinkReachBuilt(false), sinkReachTime(0), numOfPrunedSources(0), numOfRegionVisits(0),
+        numOfRegionNodes(0), svfg(nullptr), callgraph(nullptr)
     {
         saberCondAllocator = std::make_unique<SaberCondAllocator>();
     }
@@ -94,8 +140,8 @@ public:
     {
         svfg = nullptr;
 
-        delete _curSlice;
-        _curSlice = nullptr;
+        delete mainState.slice;
+        mainState.slice = nullptr;
 
         /// the following shared by multiple checkers, thus can not be released.
         //if (callgraph != nullptr)
@@ -110,13 +156,32 @@ public:
     /// Start analysis here
     virtual void analyze(SVFModule* module);
 
+    /// Analyse the slices of sources with Options::SaberThreads() workers, reporting in source order
+    void analyzeInParallel();
+
     /// Initialize analysis
     virtual void initialize(SVFModule* module);
 
+    /// Compute the SVFG nodes from which some sink is reachable, by a backward sweep from all sinks
+    void buildSinkReachability();
+
+    /// Whether some sink may be reachable from node, always true before buildSinkReachability
+    inline bool mayReachSink(const SVFGNode* node) const
+    {
+        return !sinkReachBuilt || sinkReachableNodes.test(node->getId());
+    }
+
     /// Finalize analysis
     virtual void finalize()
     {
         dumpSlices();
+        if (Options::PStat())
+        {
+            printSinkReachStat();
+            printBudgetStat();
+            printSharedSliceStat();
+            printZ3Stat();
+        }
     }
 
     /// Get SVFIR
@@ -148,28 +213,28 @@ public:
 
     inline ProgSlice* getCurSlice() const
     {
-        return _curSlice;
+        return curState().slice;
     }
     inline void addSinkToCurSlice(const SVFGNode* node)
     {
-        _curSlice->addToSinks(node);
+        curState().slice->addToSinks(node);
         addToCurForwardSlice(node);
     }
     inline bool isInCurForwardSlice(const SVFGNode* node)
     {
-        return _curSlice->inForwardSlice(node);
+        return curState().slice->inForwardSlice(node);
     }
     inline bool isInCurBackwardSlice(const SVFGNode* node)
     {
-        return _curSlice->inBackwardSlice(node);
+        return curState().slice->inBackwardSlice(node);
     }
     inline void addToCurForwardSlice(const SVFGNode* node)
     {
-        _curSlice->addToForwardSlice(node);
+        curState().slice->addToForwardSlice(node);
     }
     inline void addToCurBackwardSlice(const SVFGNode* node)
     {
-        _curSlice->addToBackwardSlice(node);
+        curState().slice->addToBackwardSlice(node);
     }
     //@}
 
@@ -251,15 +316,57 @@ public:
         return report;
     }
 
+    /// Sources given up after exhausting a budget, in reporting order
+    inline const std::vector<std::pair<const SVFGNode*, ProgSlice::BudgetKind>>& getUnknownSources() const
+    {
+        return unknownSources;
+    }
+
 protected:
+    /// Create the slice of a source with the budgets of Options
+    ProgSlice* createSlice(const SVFGNode* src);
+    /// Forward and backward traversal of the current slice, free of path conditions
+    void traverseCurSlice();
+    /// Solve the path conditions of the current slice, return false if it is not solved
+    /// as it reaches a global or exhausted some budget during traversal
+    bool solveCurSlice();
+    /// Report the current slice, annotating it if it was solved
+    void reportCurSlice(bool solved);
+    /// Report a slice whose budget was exhausted as unknown instead of its bugs
+    void reportUnknown(ProgSlice* slice);
+    /// Add the cost of a finished slice to the histograms
+    void recordSliceCost(const ProgSlice* slice);
+
+    /// Forward traverse by whole regions if Options::SaberSharedSlice()
+    void forwardTraverse(DPIm& it) override;
+    /// Region of a node, computing the regions of its SCC and of all SCCs it reaches if needed
+    const SliceRegion& getSliceRegion(const SVFGNode* node);
+    /// Compute the region of an SCC from the regions of its successor SCCs
+    void buildSliceRegion(const std::vector<NodeID>& scc);
+    /// Whether a traversal keeps its context along an edge
+    static inline bool isContextPreserving(const SVFGEdge* edge)
+    {
+        return !edge->isCallVFGEdge() && !edge->isRetVFGEdge();
+    }
+
+    /// Each slice state has its own worklist
+    inline CFLSrcSnkSolver::WorkList& getWorklist() override
+    {
+        return curState().worklist;
+    }
     /// Forward traverse
     inline void FWProcessCurNode(const DPIm& item) override
     {
+        if (!curState().slice->chargeNode())
+        {
+            clearWorklist();
+            return;
+        }
         const SVFGNode* node = getNode(item.getCurNodeID());
         if(isSink(node))
         {
             addSinkToCurSlice(node);
-            _curSlice->setPartialReachable();
+            curState().slice->setPartialReachable();
         }
         else
             addToCurForwardSlice(node);
@@ -267,6 +374,11 @@ protected:
     /// Backward traverse
     inline void BWProcessCurNode(const DPIm& item) override
     {
+        if (!curState().slice->chargeNode())
+        {
+            clearWorklist();
+            return;
+        }
         const SVFGNode* node = getNode(item.getCurNodeID());
         if(isInCurForwardSlice(node))
         {
@@ -281,55 +393,65 @@ protected:
     //@{
     inline bool forwardVisited(const SVFGNode* node, const DPIm& item)
     {
-        SVFGNodeToDPItemsMap::const_iterator it = nodeToDPItemsMap.find(node);
-        if(it!=nodeToDPItemsMap.end())
+        SVFGNodeToDPItemsMap::const_iterator it = curState().nodeToDPItemsMap.find(node);
+        if(it!=curState().nodeToDPItemsMap.end())
             return it->second.find(item)!=it->second.end();
         else
             return false;
     }
     inline void addForwardVisited(const SVFGNode* node, const DPIm& item)
     {
-        nodeToDPItemsMap[node].insert(item);
+        curState().nodeToDPItemsMap[node].insert(item);
+    }
+    /// Whether the node has been added to the slice by a region traversal in the item's context
+    inline bool isRegionProcessed(const SVFGNode* node, const DPIm& item) const
+    {
+        Map<ContextCond, NodeBS>::const_iterator it = curState().cxtToProcessedNodes.find(item.getContexts());
+        return it != curState().cxtToProcessedNodes.end() && it->second.test(node->getId());
     }
     inline bool backwardVisited(const SVFGNode* node)
     {
-        return visitedSet.find(node)!=visitedSet.end();
+        return curState().visitedSet.find(node)!=curState().visitedSet.end();
     }
 
     inline void addBackwardVisited(const SVFGNode* node)
     {
-        visitedSet.insert(node);
+        curState().visitedSet.insert(node);
     }
     inline void clearVisitedMap()
     {
-        nodeToDPItemsMap.clear();
-        visitedSet.clear();
+        curState().nodeToDPItemsMap.clear();
+        curState().cxtToProcessedNodes.clear();
+        curState().visitedSet.clear();
     }
     inline void clearVisitedSet()
     {
-        visitedSet.clear();
+        curState().visitedSet.clear();
     }
     inline void clearNodeToDPItemsMap()
     {
-        nodeToDPItemsMap.clear();
+        curState().nodeToDPItemsMap.clear();
     }
     //@}
 
     /// Whether it is all path reachable from a source
     virtual bool isAllPathReachable()
     {
-        return _curSlice->isAllReachable();
+        return curState().slice->isAllReachable();
     }
     /// Whether it is some path reachable from a source
     virtual bool isSomePathReachable()
     {
-        return _curSlice->isPartialReachable();
+        return curState().slice->isPartialReachable();
     }
     /// Dump SVFG with annotated slice information
     //@{
     void dumpSlices();
     void annotateSlice(ProgSlice* slice);
     void printZ3Stat();
+    void printSinkReachStat();
+    void printBudgetStat();
+    void printSharedSliceStat();
     //@}
 
 };
@@ -102,6 +102,18 @@ private:
 
     // 当前进行信息流检查分析的读调用点
     const CallICFGNode* curReadSite{nullptr};
+
+    /// Taint transfer summary of a function entry (a node with incoming call edges):
+    /// what taint entering the callee there reaches before returning to the caller
+    struct TaintSummary
+    {
+        Set<const CallICFGNode*> writeSites;	///< write sites receiving the taint, in the callee or its callees
+        Set<const StoreSVFGNode*> stores;	///< stores writing the taint to memory
+        Set<const SVFGNode*> exits;		///< formal-ret/out nodes returning the taint to the caller
+    };
+    typedef Map<const SVFGNode*, TaintSummary> SVFGNodeToTaintSummaryMap;
+
+    SVFGNodeToTaintSummaryMap entryToTaintSummary;
     
 
     // 暂时还没用
@@ -266,6 +278,17 @@ public:
    // override the base class function
     void analyze(SVFModule* module) override;
 
+    /// Function-level taint summaries
+    //@{
+    /// Compute the summaries of all function entries bottom-up over call graph SCCs
+    void buildTaintSummaries();
+    /// Propagate taint from start, applying callee summaries at call edges. Return edges are
+    /// followed to every caller if unbalanced, otherwise their sources are recorded as exits
+    void propagateTaint(const SVFGNode* start, TaintSummary& reached, bool unbalanced);
+    /// Flood a source with summaries instead of descending into callees
+    void floodWithSummaries(const SVFGNode* src);
+    //@}
+
 
     inline bool isOpenLikeFun(const SVFFunction* fun)  {
         return open_map.find(fun->getName()) != open_map.end();
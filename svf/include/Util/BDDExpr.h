@@ -0,0 +1,332 @@
+//===- BDDExpr.h -- BDD conditions----------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * BDDExpr.h
+ *
+ * A small reduced ordered BDD package for conditions which are pure Boolean
+ * combinations of branch variables. Nodes are hash-consed in a unique table,
+ * so two equivalent conditions are the same node, and results of AND/OR/NEG
+ * are memoised in a computed cache. Nodes are reference counted by BDDExpr
+ * handles and unreferenced nodes are reclaimed by a mark-and-sweep collection
+ * once the node table reaches a threshold.
+ */
+
+#ifndef BDDEXPR_H_
+#define BDDEXPR_H_
+
+#include "SVFIR/SVFType.h"
+
+namespace SVF
+{
+
+class BDDManager
+{
+public:
+    static constexpr u32_t FalseNode = 0;
+    static constexpr u32_t TrueNode = 1;
+    static constexpr u32_t NullNode = UINT32_MAX;	///< not a condition, e.g., a branch which cannot be evaluated
+
+    /// Get the BDD manager, singleton design here as all conditions must share one unique table
+    static BDDManager& getManager();
+
+    /// Release the manager and all its nodes
+    static void releaseManager();
+
+    /// Whether the manager has been created (handles may outlive it at program exit)
+    static inline bool hasManager()
+    {
+        return mgr != nullptr;
+    }
+
+    /// Allocate a fresh variable, ordered after every existing one, and return its positive literal
+    u32_t newVar();
+
+    /// The positive or negative literal of variable var
+    inline u32_t getLiteral(u32_t var, bool positive)
+    {
+        return positive ? mk(var, FalseNode, TrueNode) : mk(var, TrueNode, FalseNode);
+    }
+
+    /// Boolean operations, the operands must be referenced by the caller
+    //@{
+    u32_t AND(u32_t lhs, u32_t rhs);
+    u32_t OR(u32_t lhs, u32_t rhs);
+    u32_t NEG(u32_t node);
+    //@}
+
+    /// Reference counting of nodes held by BDDExpr
+    //@{
+    inline void incRef(u32_t node)
+    {
+        if (node > TrueNode && node != NullNode)
+            nodes[node].ref++;
+    }
+    inline void decRef(u32_t node)
+    {
+        if (node > TrueNode && node != NullNode)
+        {
+            assert(nodes[node].ref > 0 && "dereferencing a dead BDD node?");
+            nodes[node].ref--;
+        }
+    }
+    //@}
+
+    /// Variables a condition depends on
+    void support(u32_t node, NodeBS& vars) const;
+
+    /// Disjunction of the paths to true, e.g., "(c0 & !c2) | c1"
+    std::string dumpStr(u32_t node) const;
+
+    /// Statistics
+    //@{
+    inline u32_t getNumOfVars() const
+    {
+        return numOfVars;
+    }
+    inline u32_t getNumOfLiveNodes() const
+    {
+        return nodes.size() - freeNodes.size();
+    }
+    inline u32_t getNumOfGC() const
+    {
+        return numOfGC;
+    }
+    //@}
+
+private:
+    static constexpr u32_t TermVar = UINT32_MAX;	///< variable of the terminals, below every variable
+    static constexpr u32_t FreeVar = UINT32_MAX - 1;	///< variable of reclaimed nodes
+
+    enum Op
+    {
+        AndOp, OrOp, NegOp
+    };
+
+    struct Node
+    {
+        u32_t var;
+        u32_t low;	///< cofactor of var = false
+        u32_t high;	///< cofactor of var = true
+        u32_t ref;	///< number of BDDExpr handles
+        u32_t next;	///< next node in the same bucket of the unique table
+    };
+
+    struct CacheEntry
+    {
+        u32_t op;
+        u32_t lhs;
+        u32_t rhs;
+        u32_t res;
+    };
+
+    BDDManager();
+
+    /// Find or create the node (var, low, high) in the unique table
+    u32_t mk(u32_t var, u32_t low, u32_t high);
+
+    /// Recursive operations, no collection may happen here as intermediate results are unreferenced
+    //@{
+    u32_t apply(Op op, u32_t lhs, u32_t rhs);
+    u32_t negate(u32_t node);
+    //@}
+
+    /// Computed cache
+    //@{
+    inline CacheEntry& getCacheEntry(Op op, u32_t lhs, u32_t rhs)
+    {
+        size_t h = ((size_t)lhs * 12582917u) ^ ((size_t)rhs * 4256249u) ^ ((size_t)op * 741457u);
+        return cache[h & (cache.size() - 1)];
+    }
+    //@}
+
+    inline size_t hashNode(u32_t var, u32_t low, u32_t high) const
+    {
+        size_t h = ((size_t)var * 12582917u) ^ ((size_t)low * 4256249u) ^ ((size_t)high * 741457u);
+        return h & (buckets.size() - 1);
+    }
+
+    /// Collect garbage before a top-level operation if the table is full
+    inline void collectIfFull()
+    {
+        if (freeNodes.empty() && nodes.size() >= gcThreshold)
+            collectGarbage();
+    }
+
+    /// Reclaim the nodes unreachable from referenced ones
+    void collectGarbage();
+
+    /// Rebuild the unique table with size buckets
+    void rehash(size_t size);
+
+    static BDDManager* mgr;
+
+    std::vector<Node> nodes;
+    std::vector<u32_t> buckets;		///< unique table, heads of node chains
+    std::vector<u32_t> freeNodes;	///< reclaimed nodes
+    std::vector<CacheEntry> cache;	///< computed cache, direct mapped
+    u32_t numOfVars;
+    u32_t gcThreshold;			///< table size triggering the next collection
+    u32_t numOfGC;
+};
+
+/*!
+ * A condition represented as a BDD node
+ */
+class BDDExpr
+{
+private:
+    u32_t node;
+
+public:
+    BDDExpr() : node(BDDManager::NullNode)
+    {
+    }
+
+    explicit BDDExpr(u32_t n) : node(n)
+    {
+        BDDManager::getManager().incRef(node);
+    }
+
+    BDDExpr(const BDDExpr& rhs) : node(rhs.node)
+    {
+        BDDManager::getManager().incRef(node);
+    }
+
+    BDDExpr(BDDExpr&& rhs) noexcept : node(rhs.node)
+    {
+        rhs.node = BDDManager::NullNode;
+    }
+
+    ~BDDExpr()
+    {
+        if (BDDManager::hasManager())
+            BDDManager::getManager().decRef(node);
+    }
+
+    inline BDDExpr& operator=(const BDDExpr& rhs)
+    {
+        if (node != rhs.node)
+        {
+            BDDManager::getManager().incRef(rhs.node);
+            BDDManager::getManager().decRef(node);
+            node = rhs.node;
+        }
+        return *this;
+    }
+
+    inline BDDExpr& operator=(BDDExpr&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            if (BDDManager::hasManager())
+                BDDManager::getManager().decRef(node);
+            node = rhs.node;
+            rhs.node = BDDManager::NullNode;
+        }
+        return *this;
+    }
+
+    /// get id, equivalent conditions have the same id
+    inline u32_t id() const
+    {
+        return node;
+    }
+
+    inline bool isTrue() const
+    {
+        return node == BDDManager::TrueNode;
+    }
+
+    inline bool isFalse() const
+    {
+        return node == BDDManager::FalseNode;
+    }
+
+    friend bool eq(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return lhs.node == rhs.node;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const BDDExpr& expr)
+    {
+        out << dumpStr(expr);
+        return out;
+    }
+
+    /// output BDD as a string
+    static inline std::string dumpStr(const BDDExpr& expr)
+    {
+        return BDDManager::getManager().dumpStr(expr.node);
+    }
+
+    /// Return a fresh branch variable
+    static inline BDDExpr newVar()
+    {
+        return BDDExpr(BDDManager::getManager().newVar());
+    }
+
+    /// Return a literal of an existing branch variable
+    static inline BDDExpr getLiteral(u32_t var, bool positive)
+    {
+        return BDDExpr(BDDManager::getManager().getLiteral(var, positive));
+    }
+
+    /// Return the unique true condition
+    static inline BDDExpr getTrueCond()
+    {
+        return BDDExpr(BDDManager::TrueNode);
+    }
+
+    /// Return the unique false condition
+    static inline BDDExpr getFalseCond()
+    {
+        return BDDExpr(BDDManager::FalseNode);
+    }
+
+    /// null expression
+    static inline BDDExpr nullExpr()
+    {
+        return BDDExpr();
+    }
+
+    /// compute NEG
+    static inline BDDExpr NEG(const BDDExpr& expr)
+    {
+        return BDDExpr(BDDManager::getManager().NEG(expr.node));
+    }
+
+    /// compute AND, used for branch condition
+    static inline BDDExpr AND(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return BDDExpr(BDDManager::getManager().AND(lhs.node, rhs.node));
+    }
+
+    /// compute OR, used for branch condition
+    static inline BDDExpr OR(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return BDDExpr(BDDManager::getManager().OR(lhs.node, rhs.node));
+    }
+};
+
+} // End namespace SVF
+
+#endif /* BDDEXPR_H_ */
@@ -32,6 +32,7 @@
 
 #include "MemoryModel/ConditionalPT.h"
 #include <algorithm>    // std::sort
+#include <atomic>
 
 namespace SVF
 {
@@ -46,7 +47,8 @@ class DPItem
 protected:
     NodeID cur;
     NodeID parent{0};
-    static u64_t maximumBudget;
+    /// thread-local, so that solvers of a parallel query pool can each set their own budget
+    static thread_local u64_t maximumBudget;
 
 public:
     /// Constructor
@@ -294,8 +296,7 @@ public:
         {
             context.push_back(ctx);
 
-            if(context.size() > maximumCxt)
-                maximumCxt = context.size();
+            updateMaximum(maximumCxt, context.size());
             return true;
         }
         else   /// handle out of context limit case
@@ -386,8 +387,14 @@ protected:
     static u32_t maximumPathLen;
     bool concreteCxt;
 public:
-    static u32_t maximumCxt;
-    static u32_t maximumPath;
+    static std::atomic<u32_t> maximumCxt;
+    static std::atomic<u32_t> maximumPath;
+    /// Raise max to val, concurrent updates of the solvers of a parallel query pool are not lost
+    static inline void updateMaximum(std::atomic<u32_t>& max, u32_t val)
+    {
+        u32_t cur = max.load();
+        while (val > cur && !max.compare_exchange_weak(cur, val)) {}
+    }
 };
 
 /*!
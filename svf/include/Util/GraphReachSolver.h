@@ -153,25 +153,30 @@ protected:
     //@}
     /// Worklist operations
     //@{
+    /// The worklist being solved, overridden by solvers that traverse several graphs concurrently
+    virtual inline WorkList& getWorklist()
+    {
+        return worklist;
+    }
     inline DPIm popFromWorklist()
     {
-        return worklist.pop();
+        return getWorklist().pop();
     }
     inline bool pushIntoWorklist(DPIm& item)
     {
-        return worklist.push(item);
+        return getWorklist().push(item);
     }
     inline bool isWorklistEmpty()
     {
-        return worklist.empty();
+        return getWorklist().empty();
     }
     inline bool isInWorklist(DPIm& item)
     {
-        return worklist.find(item);
+        return getWorklist().find(item);
     }
     inline void clearWorklist()
     {
-        worklist.clear();
+        getWorklist().clear();
     }
     //@}
 
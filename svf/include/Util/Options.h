@@ -71,12 +71,27 @@ public:
     /// Time limit for the main phase (i.e., the actual solving) of FS analyses.
     static const Option<u32_t> FsTimeLimit;
 
+    /// Number of nodes FS analyses process between sweeps of unused persistent points-to sets.
+    static const Option<u32_t> PtsGcInterval;
+
+    /// File FS analyses periodically write their solver state to.
+    static const Option<std::string> FsCheckpoint;
+
+    /// Seconds between checkpoints of FS analyses.
+    static const Option<u32_t> FsCheckpointInterval;
+
+    /// Checkpoint file FS analyses resume solving from.
+    static const Option<std::string> FsResume;
+
     /// Time limit for the Andersen's analyses.
     static const Option<u32_t> AnderTimeLimit;
 
     /// Number of threads for the versioning phase.
     static const Option<u32_t> VersioningThreads;
 
+    /// Number of threads for the version propagation phase of the main solve.
+    static const Option<u32_t> VersionPropThreads;
+
     // ContextDDA.cpp
     static const Option<u32_t> CxtBudget;
 
@@ -85,6 +100,12 @@ public:
     static const Option<u32_t> MaxContextLen;
     static const Option<u32_t> MaxStepInWrapper;
     static const Option<std::string> UserInputQuery;
+    static const Option<u32_t> DDAThreads;
+    static const Option<std::string> DDAQueryCache;
+    static const Option<bool> DDAAdaptive;
+    static const Option<std::string> DDAQueryProfile;
+    static const Option<bool> DDASummary;
+    static const Option<std::string> DDAServer;
     static const Option<bool> InsenRecur;
     static const Option<bool> InsenCycle;
     static const Option<bool> PrintCPts;
@@ -106,6 +127,7 @@ public:
     static const Option<bool> ContextInsensitive;
     static const Option<bool> KeepAOFI;
     static const Option<std::string> SelfCycle;
+    static const Option<u32_t> SVFGOptThreads;
 
     // Sparse value-flow graph (VFG.cpp)
     static const Option<bool> DumpVFG;
@@ -143,6 +165,7 @@ public:
     static const Option<std::string> MSSAFun;
     // static const llvm::cl::opt<string> MSSAFun;
     static const OptionMap<MemSSA::MemPartition> MemPar;
+    static const Option<u32_t> MSSAThreads;
 
     // SVFG builder (SVFGBuilder.cpp)
     static const Option<bool> SVFGWithIndirectCall;
@@ -150,7 +173,9 @@ public:
 
     static const Option<std::string> WriteSVFG;
     static const Option<std::string> ReadSVFG;
+    static const Option<bool> WriteSVFGBinary;
     static const Option<std::string> ReadTaintConfig;
+    static const Option<bool> TaintSummary;
 
     // LockAnalysis.cpp
     static const Option<bool> IntraLock;
@@ -172,6 +197,12 @@ public:
     // Source-sink analyzer (SrcSnkDDA.cpp)
     static const Option<bool> DumpSlice;
     static const Option<u32_t> CxtLimit;
+    static const Option<u32_t> SaberThreads;
+    static const Option<bool> SaberSinkReach;
+    static const Option<u32_t> SaberNodeBudget;
+    static const Option<u32_t> SaberGuardBudget;
+    static const Option<u32_t> SaberTimeBudget;
+    static const Option<bool> SaberSharedSlice;
 
     // CHG.cpp
     static const Option<bool> DumpCHA;
@@ -192,12 +223,14 @@ public:
 
     // Conditions.cpp
     static const Option<u32_t> MaxZ3Size;
+    static const Option<u32_t> Z3CacheSize;
 
     // BoundedZ3Expr.cpp
     static const Option<u32_t> MaxBVLen;
 
     // SaberCondAllocator.cpp
     static const Option<bool> PrintPathCond;
+    static const Option<bool> SaberBDD;
 
     // SaberSVFGBuilder.cpp
     static const Option<bool> CollectExtRetGlobals;
@@ -251,6 +284,9 @@ public:
     static const Option<u32_t> Timeout;
     /// bug info output file, Default: output.db
     static const Option<std::string> OutputName;
+    /// files bugs are streamed to as JSON / SARIF 2.1.0, Default: none
+    static const Option<std::string> BugJson;
+    static const Option<std::string> BugSarif;
     /// buffer overflow checker, Default: false
     static const Option<bool> BufferOverflowCheck;
     /// memory leak check, Default: false
@@ -266,6 +302,14 @@ public:
     /// if the access index of gepstmt is unknown, skip it, Default: false
     static const Option<bool> GepUnknownIdx;
     static const Option<bool> RunUncallFuncs;
+    /// number of threads analysing entry functions in parallel, Default: 1
+    static const Option<u32_t> AEThreads;
+    /// max number of summaries kept for a function, 0 disables function summaries, Default: 8
+    static const Option<u32_t> AESummaryLimit;
+    /// skip re-evaluating an ICFG node whose used values did not change, Default: false
+    static const Option<bool> AEReuseEvals;
+    /// drop the state of a node once no later node of its function reads it, Default: false
+    static const Option<bool> AEEvictStates;
 
     static const Option<bool> ICFGMergeAdjacentNodes;
 
@@ -36,6 +36,8 @@
 #include <map>
 #include "Util/cJSON.h"
 #include <set>
+#include <fstream>
+#include <mutex>
 
 #define BRANCHFLAGMASK 0x00000010
 #define EVENTTYPEMASK 0x0000000f
@@ -285,6 +287,61 @@ public:
     }
 };
 
+/*!
+ * Writes bugs to the files given by -bug-json and -bug-sarif as soon as they
+ * are confirmed, instead of keeping them until the end of the analysis. All
+ * reports of a run share one stream. A bug whose type and event locations
+ * were already written is dropped; only a 64-bit hash of each written bug is
+ * kept for this. The files are completed when the program exits.
+ */
+class SVFBugStream
+{
+public:
+    /// The stream of this run, nullptr if neither -bug-json nor -bug-sarif is given
+    static SVFBugStream* getBugStream();
+
+    /// Write a bug unless it is a duplicate, return false if it was dropped
+    bool writeBug(const GenericBug* bug);
+
+    /// Statistics written at the end of the JSON file
+    void setStat(double time, const std::string& mem, double coverage);
+
+    /// Write the trailers and close both files
+    void close();
+
+    inline u32_t getNumOfWrittenBugs() const
+    {
+        return numOfWrittenBugs;
+    }
+    inline u32_t getNumOfDuplicateBugs() const
+    {
+        return numOfDuplicateBugs;
+    }
+
+    ~SVFBugStream();
+
+private:
+    static constexpr size_t BufferSize = 1 << 20;
+
+    SVFBugStream(const std::string& jsonPath, const std::string& sarifPath);
+
+    /// Hash of the bug type, function and event locations
+    static u64_t hashBug(const GenericBug* bug);
+
+    std::ofstream jsonFile;
+    std::ofstream sarifFile;
+    std::vector<char> jsonBuffer;	///< write buffers of the two files
+    std::vector<char> sarifBuffer;
+    Set<u64_t> writtenBugs;		///< hashes of the bugs written so far
+    std::mutex streamMutex;		///< bugs may be reported by several threads
+    double time;
+    std::string mem;
+    double coverage;
+    u32_t numOfWrittenBugs;
+    u32_t numOfDuplicateBugs;
+    bool closed;
+};
+
 class SVFBugReport
 {
 public:
@@ -305,6 +362,8 @@ public:
         this->time = time;
         this->mem = mem;
         this->coverage = coverage;
+        if (SVFBugStream* stream = SVFBugStream::getBugStream())
+            stream->setStat(time, mem, coverage);
     }
 
     /*
@@ -321,31 +380,26 @@ public:
         case GenericBug::NEVERFREE:
         {
             newBug = new NeverFreeBug(eventStack);
-            bugSet.insert(newBug);
             break;
         }
         case GenericBug::PARTIALLEAK:
         {
             newBug = new PartialLeakBug(eventStack);
-            bugSet.insert(newBug);
             break;
         }
         case GenericBug::DOUBLEFREE:
         {
             newBug = new DoubleFreeBug(eventStack);
-            bugSet.insert(newBug);
             break;
         }
         case GenericBug::FILENEVERCLOSE:
         {
             newBug = new FileNeverCloseBug(eventStack);
-            bugSet.insert(newBug);
             break;
         }
         case GenericBug::FILEPARTIALCLOSE:
         {
             newBug = new FilePartialCloseBug(eventStack);
-            bugSet.insert(newBug);
             break;
         }
         default:
@@ -357,6 +411,7 @@ public:
 
         // when add a bug, also print it to terminal
         newBug->printBugToTerminal();
+        addBug(newBug);
     }
 
     /*
@@ -374,25 +429,21 @@ public:
         case GenericBug::FULLBUFOVERFLOW:
         {
             newBug = new FullBufferOverflowBug(eventStack, allocLowerBound, allocUpperBound, accessLowerBound, accessUpperBound);
-            bugSet.insert(newBug);
             break;
         }
         case GenericBug::PARTIALBUFOVERFLOW:
         {
             newBug = new PartialBufferOverflowBug(eventStack, allocLowerBound, allocUpperBound, accessLowerBound, accessUpperBound);
-            bugSet.insert(newBug);
             break;
         }
         case GenericBug::FULLNULLPTRDEREFERENCE:
         {
             newBug = new FullNullPtrDereferenceBug(eventStack);
-            bugSet.insert(newBug);
             break;
         }
         case GenericBug::PARTIALNULLPTRDEREFERENCE:
         {
             newBug = new PartialNullPtrDereferenceBug(eventStack);
-            bugSet.insert(newBug);
             break;
         }
         default:
@@ -404,6 +455,7 @@ public:
 
         // when add a bug, also print it to terminal
         //newBug->printBugToTerminal();
+        addBug(newBug);
     }
 
     /*
@@ -412,6 +464,18 @@ public:
      */
     void dumpToJsonFile(const std::string& filePath) const;
 
+    /*
+     * function: pass file path, open the file and dump bug report as SARIF 2.1.0
+     * usage: dumpToSarifFile("/path/to/file")
+     */
+    void dumpToSarifFile(const std::string& filePath) const;
+
+    /// A defect of the JSON report
+    static cJSON* bugToJson(const GenericBug* bug);
+
+    /// A result of the SARIF report
+    static cJSON* bugToSarif(const GenericBug* bug);
+
     /*
      * function: get underlying bugset
      * usage: getBugSet()
@@ -421,6 +485,19 @@ public:
         return bugSet;
     }
 
+private:
+    /// Keep a new bug, or write and release it if bugs are streamed
+    void addBug(GenericBug* bug)
+    {
+        if (SVFBugStream* stream = SVFBugStream::getBugStream())
+        {
+            stream->writeBug(bug);
+            delete bug;
+        }
+        else
+            bugSet.insert(bug);
+    }
+
 };
 }
 
@@ -41,6 +41,16 @@ public:
     static z3::context *ctx;
     static z3::solver* solver;
 
+    /// Statistics of the memoised satisfiability checks and simplifications
+    struct CacheStat
+    {
+        u64_t satQueries = 0;
+        u64_t satHits = 0;
+        u64_t simplifyQueries = 0;
+        u64_t simplifyHits = 0;
+        double satTime = 0;		///< time spent by the solver on cache misses
+    };
+
 private:
     z3::expr e;
 
@@ -100,6 +110,42 @@ public:
     /// release z3 solver
     static void releaseSolver();
 
+    /// Memoised queries, keyed by the id of the hash-consed expression and bounded
+    /// by Options::Z3CacheSize() entries each, least recently used ones are evicted
+    //@{
+    /// whether an expression is satisfiable (sat or unknown) in a fresh scope of the solver
+    static bool isSatisfiable(const Z3Expr &z3Expr);
+
+    /// simplified form of an expression
+    static Z3Expr getSimplified(const Z3Expr &z3Expr);
+
+    /// drop all memoised results
+    static void clearCache();
+
+    static inline const CacheStat& getCacheStat()
+    {
+        return cacheStat;
+    }
+    //@}
+
+    /// Contexts of threads, each thread building and solving expressions independently of the others.
+    /// While the context of the calling thread is enabled, getContext and getSolver return it and
+    /// memoised queries use its own caches. Expressions move between contexts via translate.
+    //@{
+    /// give the calling thread its own context, enabled
+    static void newThreadContext();
+
+    /// release the context of the calling thread, no expression of it may be alive any more;
+    /// its statistics are added to getCacheStat, so callers serialise this with other threads
+    static void releaseThreadContext();
+
+    /// switch the calling thread between its own context and the shared one
+    static void enableThreadContext(bool enable);
+
+    /// an expression of another context translated into the current one
+    static z3::expr translate(const z3::expr& e);
+    //@}
+
 
     /// null expression
     static z3::expr nullExpr()
@@ -268,7 +314,7 @@ public:
 
     friend bool eq(const Z3Expr &lhs, const Z3Expr &rhs)
     {
-        return eq(lhs.getExpr().simplify(), rhs.getExpr().simplify());
+        return eq(getSimplified(lhs).getExpr(), getSimplified(rhs).getExpr());
     }
 
     z3::sort get_sort() const
@@ -308,6 +354,9 @@ public:
 
     /// compute OR, used for branch condition
     static Z3Expr OR(const Z3Expr &lhs, const Z3Expr &rhs);
+
+private:
+    static CacheStat cacheStat;
 };
 } // End namespace SVF
 
@@ -69,6 +69,12 @@ public:
         numOfProcessedPhi = numOfProcessedActualParam = numOfProcessedFormalRet = 0;
         numOfProcessedMSSANode = 0;
         maxSCCSize = numOfSCC = numOfNodesInSCC = 0;
+        numOfProcessedSinceSweep = numOfPtsSweeps = 0;
+        numOfReclaimedPts = 0;
+        peakRSSAtSweep = reclaimedRSS = 0;
+        ptsSweepTime = 0;
+        numOfCheckpoints = 0;
+        lastCheckpointTime = checkpointTime = resumeTime = 0;
         iterationForPrintStat = OnTheFlyIterBudgetForStat;
     }
 
@@ -214,6 +220,24 @@ protected:
     }
     //@}
 
+    /// Solve the worklist, sweeping the points-to cache every PtsGcInterval nodes.
+    void solveWorklist() override;
+
+    /// Free persistent points-to sets which are no longer in use.
+    void sweepPts(void);
+
+    /// Checkpointing
+    //@{
+    /// Write the solver state to filename (through a temporary file so a
+    /// crash mid-write leaves the previous checkpoint intact).
+    virtual void writeCheckpoint(const std::string& filename);
+    /// Restore the solver state from a file written by writeCheckpoint.
+    virtual bool resumeFromCheckpoint(const std::string& filename);
+    /// Write/read the points-to sets of address-taken objects (IN/OUT sets).
+    virtual void writeAddrTakenPtsToFile(std::fstream& f);
+    virtual void readAddrTakenPtsFromFile(std::ifstream& F);
+    //@}
+
     /// Handle various constraints
     //@{
     void processNode(NodeID nodeId) override;
@@ -297,6 +321,13 @@ protected:
     u32_t numOfSCC;
     u32_t numOfNodesInSCC;
 
+    u32_t numOfProcessedSinceSweep;	///< Nodes processed since the last points-to cache sweep
+    u32_t numOfPtsSweeps;	///< Number of points-to cache sweeps
+    u64_t numOfReclaimedPts;	///< Number of points-to sets freed by sweeps
+    u32_t peakRSSAtSweep;	///< Largest RSS (KB) observed before a sweep
+    u32_t reclaimedRSS;	///< RSS (KB) released by sweeps
+    u32_t numOfCheckpoints;	///< Number of checkpoints written
+
     double solveTime;	///< time of solve.
     double sccTime;	///< time of SCC detection.
     double processTime;	///< time of processNode.
@@ -311,6 +342,10 @@ protected:
     double storeTime;	///< time of store edges
     double phiTime;	///< time of phi nodes.
     double updateCallGraphTime; ///< time of updating call graph
+    double ptsSweepTime;	///< time of points-to cache sweeps
+    double lastCheckpointTime;	///< clock when the last checkpoint was written
+    double checkpointTime;	///< time of writing checkpoints
+    double resumeTime;	///< time of restoring a checkpoint
 
     NodeBS svfgHasSU;
     //@}
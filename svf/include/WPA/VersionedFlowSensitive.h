@@ -102,6 +102,25 @@ protected:
     virtual void processNode(NodeID n) override;
     virtual void updateConnectedNodes(const SVFGEdgeSetTy& newEdges) override;
 
+    /// Override to interleave the sequential solve with the parallel version
+    /// propagation phase when more than one propagation thread is requested.
+    virtual void solveWorklist() override;
+
+    /// Override to flush pending version propagation before checkpointing.
+    virtual void writeCheckpoint(const std::string& filename) override;
+
+    /// Override to store versioned rather than IN/OUT points-to sets.
+    //@{
+    virtual void writeAddrTakenPtsToFile(std::fstream& f) override
+    {
+        writeVersionedPtsToFile(f);
+    }
+    virtual void readAddrTakenPtsFromFile(std::ifstream& F) override
+    {
+        readVersionedAnalysisResultFromFile(F);
+    }
+    //@}
+
     /// Override to do nothing. Instead, we will use propagateVersion when necessary.
     virtual bool propAlongIndirectEdge(const IndirectSVFGEdge*) override
     {
@@ -131,6 +150,14 @@ private:
     /// taken itself.
     void propagateVersion(const NodeID o, const Version v, const Version vp, bool time=true);
 
+    /// Returns true if version propagation is deferred to the parallel phase.
+    static bool parallelVersionProp(void);
+
+    /// Propagates all versions recorded in pendingVersions to their reliant versions
+    /// (transitively), objects being distributed across VersionPropThreads workers.
+    /// Adds any statements which rely on changed versions to the worklist.
+    void propagatePendingVersions(void);
+
     /// Fills in isStoreMap and isLoadMap.
     virtual void buildIsStoreLoadMaps(void);
 
@@ -184,6 +211,7 @@ private:
     void solveAndwritePtsToFile(const std::string& filename) override;
 
     void writeVersionedAnalysisResultToFile(const std::string& filename);
+    void writeVersionedPtsToFile(std::fstream& f);
 
     void readVersionedAnalysisResultFromFile(std::ifstream& F);
 
@@ -207,6 +235,10 @@ private:
     /// needs to be propagated.
     VarToPropNodeMap versionedVarToPropNode;
 
+    /// o -> versions of o which changed and are yet to be propagated. Only
+    /// used when version propagation is parallel (instead of the dummy nodes).
+    Map<NodeID, Set<Version>> pendingVersions;
+
     // Maps an object o to o' if o is equivalent to o' with respect to
     // versioning. Thus, we don't need to store the versions of o and look
     // up those for o' instead.
@@ -244,6 +276,11 @@ private:
     double prelabelingTime;  ///< Time to prelabel SVFG.
     double meldLabelingTime; ///< Time to meld label SVFG.
     double versionPropTime;  ///< Time to propagate versions to versions which rely on them.
+
+    u32_t numParVersionPropRounds;   ///< Number of parallel version propagation rounds.
+    u32_t numParVersionPropObjects;  ///< Number of objects propagated in parallel rounds.
+    u32_t numParVersionPropUpdates;  ///< Number of versions changed in parallel rounds.
+    double parVersionPropTime;       ///< Time spent in the parallel part of version propagation.
     //@}
 
     static VersionedFlowSensitive *vfspta;
@@ -58,100 +58,87 @@ u32_t AbstractState::hash() const
     return pairH({h, h2});
 }
 
+/// Widen (or narrow) the intervals of es by those of other, lhs is the map of es before
+/// any change; a value shared by lhs and other is unchanged and skipped
+template<typename Op>
+static void updateIntervals(AbstractState::VarToAbsValMap& es, const AbstractState::VarToAbsValMap& lhs,
+                            const AbstractState::VarToAbsValMap& other, Op op)
+{
+    other.forEachDiff(lhs, [&](const AbstractState::VarToAbsValMap::value_type& item)
+    {
+        const AbstractValue* otherVal = other.lookup(item.first);
+        if (otherVal && item.second.isInterval() && otherVal->isInterval())
+            op(es[item.first].getInterval(), otherVal->getInterval());
+        return true;
+    });
+}
+
 AbstractState AbstractState::widening(const AbstractState& other)
 {
     // widen interval
     AbstractState es = *this;
-    for (auto it = es._varToAbsVal.begin(); it != es._varToAbsVal.end(); ++it)
+    auto widen = [](IntervalValue& lhs, const IntervalValue& rhs)
     {
-        auto key = it->first;
-        if (other._varToAbsVal.find(key) != other._varToAbsVal.end())
-            if (it->second.isInterval() && other._varToAbsVal.at(key).isInterval())
-                it->second.getInterval().widen_with(other._varToAbsVal.at(key).getInterval());
-    }
-    for (auto it = es._addrToAbsVal.begin(); it != es._addrToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        if (other._addrToAbsVal.find(key) != other._addrToAbsVal.end())
-            if (it->second.isInterval() && other._addrToAbsVal.at(key).isInterval())
-                it->second.getInterval().widen_with(other._addrToAbsVal.at(key).getInterval());
-    }
+        lhs.widen_with(rhs);
+    };
+    updateIntervals(es._varToAbsVal, _varToAbsVal, other._varToAbsVal, widen);
+    updateIntervals(es._addrToAbsVal, _addrToAbsVal, other._addrToAbsVal, widen);
     return es;
 }
 
 AbstractState AbstractState::narrowing(const AbstractState& other)
 {
     AbstractState es = *this;
-    for (auto it = es._varToAbsVal.begin(); it != es._varToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        if (other._varToAbsVal.find(key) != other._varToAbsVal.end())
-            if (it->second.isInterval() && other._varToAbsVal.at(key).isInterval())
-                it->second.getInterval().narrow_with(other._varToAbsVal.at(key).getInterval());
-    }
-    for (auto it = es._addrToAbsVal.begin(); it != es._addrToAbsVal.end(); ++it)
+    auto narrow = [](IntervalValue& lhs, const IntervalValue& rhs)
     {
-        auto key = it->first;
-        if (other._addrToAbsVal.find(key) != other._addrToAbsVal.end())
-            if (it->second.isInterval() && other._addrToAbsVal.at(key).isInterval())
-                it->second.getInterval().narrow_with(other._addrToAbsVal.at(key).getInterval());
-    }
+        lhs.narrow_with(rhs);
+    };
+    updateIntervals(es._varToAbsVal, _varToAbsVal, other._varToAbsVal, narrow);
+    updateIntervals(es._addrToAbsVal, _addrToAbsVal, other._addrToAbsVal, narrow);
     return es;
 
 }
 
-/// domain join with other, important! other widen this.
-void AbstractState::joinWith(const AbstractState& other)
+/// Join (or meet) the values of map with those of other, values shared with other
+/// are skipped as the operation does not change them
+template<typename Op>
+static void updateValues(AbstractState::VarToAbsValMap& map, const AbstractState::VarToAbsValMap& other,
+                         bool insertMissing, Op op)
 {
-    for (auto it = other._varToAbsVal.begin(); it != other._varToAbsVal.end(); ++it)
+    map.forEachDiff(other, [&](const AbstractState::VarToAbsValMap::value_type& item)
     {
-        auto key = it->first;
-        auto oit = _varToAbsVal.find(key);
-        if (oit != _varToAbsVal.end())
+        const AbstractValue* val = map.lookup(item.first);
+        if (!val)
         {
-            oit->second.join_with(it->second);
+            if (insertMissing)
+                map[item.first] = item.second;
         }
-        else
-        {
-            _varToAbsVal.emplace(key, it->second);
-        }
-    }
-    for (auto it = other._addrToAbsVal.begin(); it != other._addrToAbsVal.end(); ++it)
+        else if (!val->equals(item.second))
+            op(map[item.first], item.second);
+        return true;
+    });
+}
+
+/// domain join with other, important! other widen this.
+void AbstractState::joinWith(const AbstractState& other)
+{
+    auto join = [](AbstractValue& lhs, const AbstractValue& rhs)
     {
-        auto key = it->first;
-        auto oit = _addrToAbsVal.find(key);
-        if (oit != _addrToAbsVal.end())
-        {
-            oit->second.join_with(it->second);
-        }
-        else
-        {
-            _addrToAbsVal.emplace(key, it->second);
-        }
-    }
+        lhs.join_with(rhs);
+    };
+    updateValues(_varToAbsVal, other._varToAbsVal, true, join);
+    updateValues(_addrToAbsVal, other._addrToAbsVal, true, join);
 }
 
 /// domain meet with other, important! other widen this.
 void AbstractState::meetWith(const AbstractState& other)
 {
-    for (auto it = other._varToAbsVal.begin(); it != other._varToAbsVal.end(); ++it)
+    auto meet = [](AbstractValue& lhs, const AbstractValue& rhs)
     {
-        auto key = it->first;
-        auto oit = _varToAbsVal.find(key);
-        if (oit != _varToAbsVal.end())
-        {
-            oit->second.meet_with(it->second);
-        }
-    }
-    for (auto it = other._addrToAbsVal.begin(); it != other._addrToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        auto oit = _addrToAbsVal.find(key);
-        if (oit != _addrToAbsVal.end())
-        {
-            oit->second.meet_with(it->second);
-        }
-    }
+        lhs.meet_with(rhs);
+    };
+    updateValues(_varToAbsVal, other._varToAbsVal, false, meet);
+    updateValues(_addrToAbsVal, other._addrToAbsVal, false, meet);
 }
 
 // getGepObjAddrs
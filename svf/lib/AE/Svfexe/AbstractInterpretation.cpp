@@ -32,11 +32,15 @@
 #include "Util/WorkList.h"
 #include "Graphs/CallGraph.h"
 #include <cmath>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
 using namespace z3;
 
+thread_local AbstractInterpretation* AbstractInterpretation::workerInstance = nullptr;
 
 void AbstractInterpretation::runOnModule(ICFG *_icfg)
 {
@@ -107,11 +111,151 @@ void AbstractInterpretation::analyse()
     handleGlobalNode();
     getAbsStateFromTrace(
         icfg->getGlobalICFGNode())[PAG::getPAG()->getBlkPtr()] = IntervalValue::top();
-    if (const CallGraphNode* cgn = svfir->getCallGraph()->getCallGraphNode("main"))
+
+    std::vector<const CallGraphNode*> entries = collectEntryFuns();
+    bool parallel = Options::AEThreads() > 1 && entries.size() > 1;
+    for (const auto& detector : detectors)
+        parallel = parallel && detector->clone() != nullptr;
+    if (parallel)
+    {
+        analyseInParallel(entries);
+        return;
+    }
+    for (const CallGraphNode* cgn : entries)
+        handleEntryFun(cgn);
+}
+
+std::vector<const CallGraphNode*> AbstractInterpretation::collectEntryFuns() const
+{
+    std::vector<const CallGraphNode*> entries;
+    CallGraph* callGraph = svfir->getCallGraph();
+    const CallGraphNode* mainNode = callGraph->getCallGraphNode("main");
+    if (mainNode)
+        entries.push_back(mainNode);
+    if (Options::RunUncallFuncs())
+    {
+        for (const auto& it : *callGraph)
+        {
+            const CallGraphNode* cgn = it.second;
+            if (cgn != mainNode && cgn->getInEdges().empty() && funcToWTO.count(cgn))
+                entries.push_back(cgn);
+        }
+    }
+    return entries;
+}
+
+void AbstractInterpretation::handleEntryFun(const CallGraphNode* cgn)
+{
+    curEntryNode = icfg->getFunEntryICFGNode(cgn->getFunction());
+    if (abstractTrace.find(curEntryNode) == abstractTrace.end())
+        abstractTrace[curEntryNode] = abstractTrace[icfg->getGlobalICFGNode()];
+    handleFunWTOComponents(cgn);
+    curEntryNode = nullptr;
+}
+
+/*!
+ * Analyse entries on Options::AEThreads() workers. Each entry is analysed by
+ * its own instance, starting from the state of the global node, so entries do
+ * not see each other's states as they would in the sequential mode. The
+ * ICFG, SVFIR and WTOs are only read, field objects are created beforehand. A worker finishing an entry merges every
+ * consecutive finished entry, so that bugs are reported in the order of
+ * entries whatever the scheduling.
+ */
+void AbstractInterpretation::analyseInParallel(const std::vector<const CallGraphNode*>& entries)
+{
+    createGepObjVars();
+    const u32_t numOfSVFIRNodes = svfir->getTotalNodeNum();
+    (void)numOfSVFIRNodes; // Suppress warning of unused variable under release build
+    const Set<const CallICFGNode*> initialCheckpoints = checkpoints;
+    std::vector<std::unique_ptr<AbstractInterpretation>> finished(entries.size());
+    size_t nextMerge = 0;
+    std::atomic<size_t> nextEntry(0);
+    std::mutex mergeMutex;
+
+    std::vector<std::thread> threads;
+    for (u32_t t = 0; t < Options::AEThreads(); ++t)
+    {
+        threads.push_back(std::thread([&]()
+        {
+            for (size_t i = nextEntry++; i < entries.size(); i = nextEntry++)
+            {
+                std::unique_ptr<AbstractInterpretation> worker = createWorker(initialCheckpoints);
+                workerInstance = worker.get();
+                worker->handleEntryFun(entries[i]);
+                workerInstance = nullptr;
+                assert(svfir->getTotalNodeNum() == numOfSVFIRNodes && "an AE worker added a node to the shared SVFIR");
+
+                /// release the trace now, only checkpoints, statistics and bugs are merged
+                worker->abstractTrace.clear();
+                delete worker->utils;
+                worker->utils = nullptr;
+                worker->funcToWTO.clear();
+
+                std::lock_guard<std::mutex> lock(mergeMutex);
+                finished[i] = std::move(worker);
+                for (; nextMerge < finished.size() && finished[nextMerge]; ++nextMerge)
+                {
+                    mergeWorker(*finished[nextMerge], initialCheckpoints);
+                    finished[nextMerge].reset();
+                }
+            }
+        }));
+    }
+    for (std::thread &thread : threads) thread.join();
+}
+
+/*!
+ * SVFIR::getGepObjVar adds a node on its first request of a field, which would
+ * race with the lookups of other workers. Every offset is folded into
+ * [0, max(1, getMaxFieldOffsetLimit())), so these are created here.
+ */
+void AbstractInterpretation::createGepObjVars()
+{
+    std::vector<const MemObj*> objs;
+    for (const auto& it : svfir->getSymbolInfo()->idToObjMap())
+    {
+        const MemObj* obj = it.second;
+        if (svfir->hasGNode(obj->getId()) && SVFUtil::isa<ObjVar>(svfir->getGNode(obj->getId())))
+            objs.push_back(obj);
+    }
+    for (const MemObj* obj : objs)
+    {
+        u32_t limit = std::max<u32_t>(1, obj->getMaxFieldOffsetLimit());
+        for (u32_t i = 0; i < limit; ++i)
+            svfir->getGepObjVar(obj, i);
+    }
+}
+
+std::unique_ptr<AbstractInterpretation> AbstractInterpretation::createWorker(const Set<const CallICFGNode*>& initialCheckpoints) const
+{
+    std::unique_ptr<AbstractInterpretation> worker = std::make_unique<AbstractInterpretation>();
+    worker->icfg = icfg;
+    worker->svfir = svfir;
+    worker->moduleName = moduleName;
+    worker->funcToWTO = funcToWTO;
+    worker->recursiveFuns = recursiveFuns;
+    worker->checkpoints = initialCheckpoints;
+    worker->utils = new AbsExtAPI(worker->abstractTrace);
+    const ICFGNode* globalNode = icfg->getGlobalICFGNode();
+    worker->abstractTrace[globalNode] = abstractTrace.at(globalNode);
+    for (const auto& detector : detectors)
+        worker->detectors.push_back(detector->clone());
+    return worker;
+}
+
+void AbstractInterpretation::mergeWorker(AbstractInterpretation& worker, const Set<const CallICFGNode*>& initialCheckpoints)
+{
+    /// a checkpoint is verified if some entry verified it
+    for (const CallICFGNode* checkpoint : initialCheckpoints)
     {
-        ICFGWTO* wto = funcToWTO[cgn];
-        handleWTOComponents(wto->getWTOComponents());
+        if (worker.checkpoints.find(checkpoint) == worker.checkpoints.end())
+            checkpoints.erase(checkpoint);
     }
+    for (const auto& it : worker.stat->generalNumMap)
+        stat->generalNumMap[it.first] += it.second;
+    stat->count += worker.stat->count;
+    for (u32_t i = 0; i < detectors.size(); ++i)
+        detectors[i]->mergeBugs(*worker.detectors[i]);
 }
 
 /// handle global node
@@ -163,7 +307,8 @@ bool AbstractInterpretation::mergeStatesFromPredecessors(const ICFGNode * icfgNo
     }
     if (workList.size() == 0)
     {
-        return false;
+        /// the entry function being analysed may have no callers, it then keeps its initial state
+        return icfgNode == curEntryNode && abstractTrace.find(icfgNode) != abstractTrace.end();
     }
     else
     {
@@ -478,6 +623,16 @@ void AbstractInterpretation::handleSingletonWTO(const ICFGSingletonWTO *icfgSing
     const ICFGNode* node = icfgSingletonWto->getICFGNode();
     stat->getBlockTrace()++;
 
+    NodeEvalInfo* evalInfo = Options::AEReuseEvals() ? getNodeEvalInfo(node) : nullptr;
+    if (evalInfo && reuseLastEvaluation(node, *evalInfo))
+    {
+        stat->getEvalReuses()++;
+        return;
+    }
+    AbstractState input;
+    if (evalInfo)
+        input = getAbsStateFromTrace(node);
+
     std::deque<const ICFGNode*> worklist;
 
     const std::vector<const ICFGNode*>& worklist_vec = icfg->getSubNodes(node);
@@ -499,6 +654,193 @@ void AbstractInterpretation::handleSingletonWTO(const ICFGSingletonWTO *icfgSing
             detector->detect(getAbsStateFromTrace(node), node);
         stat->countStateSize();
     }
+    if (evalInfo)
+        recordEvaluation(node, *evalInfo, input);
+}
+
+/*!
+ * Reuse of node evaluations along def-use chains. The statements of a node only
+ * read the top-level variables they use and the memory they load from, so if
+ * none of these values changed since the last evaluation of the node, its writes
+ * are the same and are applied to the state without evaluating it again.
+ * Calls and phis are always evaluated, their results depend on other nodes.
+ *
+ * This is not sparse analysis: abstract states are still propagated to every
+ * ICFG node in WTO order and widened at cycle heads, only the evaluation of the
+ * statements of a node is skipped.
+ */
+AbstractInterpretation::NodeEvalInfo* AbstractInterpretation::getNodeEvalInfo(const ICFGNode* node)
+{
+    auto it = nodeEvalInfo.find(node);
+    if (it != nodeEvalInfo.end())
+        return it->second.eligible ? &it->second : nullptr;
+
+    NodeEvalInfo& info = nodeEvalInfo[node];
+    for (const ICFGNode* subNode : icfg->getSubNodes(node))
+    {
+        if (SVFUtil::isa<CallICFGNode>(subNode))
+            info.eligible = false;
+        for (const SVFStmt* stmt : subNode->getSVFStmts())
+        {
+            if (SVFUtil::isa<PhiStmt>(stmt))
+                info.eligible = false;
+            else if (const GepStmt* gep = SVFUtil::dyn_cast<GepStmt>(stmt))
+            {
+                info.uses.push_back(gep->getRHSVarID());
+                for (const AccessPath::IdxOperandPair& pair : gep->getOffsetVarAndGepTypePairVec())
+                    info.uses.push_back(pair.first->getId());
+            }
+            else if (const LoadStmt* load = SVFUtil::dyn_cast<LoadStmt>(stmt))
+            {
+                info.uses.push_back(load->getRHSVarID());
+                info.loadPtrs.push_back(load->getRHSVarID());
+                if (std::find(info.defs.begin(), info.defs.end(), load->getRHSVarID()) != info.defs.end())
+                    info.readsAllMem = true;
+            }
+            else if (const StoreStmt* store = SVFUtil::dyn_cast<StoreStmt>(stmt))
+            {
+                info.uses.push_back(store->getLHSVarID());
+                info.uses.push_back(store->getRHSVarID());
+                info.storePtrs.push_back(store->getLHSVarID());
+            }
+            else if (const SelectStmt* select = SVFUtil::dyn_cast<SelectStmt>(stmt))
+            {
+                info.uses.push_back(select->getCondition()->getId());
+                info.uses.push_back(select->getTrueValue()->getId());
+                info.uses.push_back(select->getFalseValue()->getId());
+            }
+            else if (const MultiOpndStmt* multi = SVFUtil::dyn_cast<MultiOpndStmt>(stmt))
+            {
+                for (u32_t i = 0; i < multi->getOpVarNum(); i++)
+                    info.uses.push_back(multi->getOpVarID(i));
+            }
+            else if (const AssignStmt* assign = SVFUtil::dyn_cast<AssignStmt>(stmt))
+            {
+                info.uses.push_back(assign->getRHSVarID());
+            }
+            else if (!SVFUtil::isa<UnaryOPStmt>(stmt) && !SVFUtil::isa<BranchStmt>(stmt))
+            {
+                info.eligible = false;
+            }
+
+            if (SVFUtil::isa<StoreStmt>(stmt))
+                continue;
+            if (const AssignStmt* assign = SVFUtil::dyn_cast<AssignStmt>(stmt))
+                info.defs.push_back(assign->getLHSVarID());
+            else if (const MultiOpndStmt* multi = SVFUtil::dyn_cast<MultiOpndStmt>(stmt))
+                info.defs.push_back(multi->getResID());
+        }
+    }
+    return info.eligible ? &info : nullptr;
+}
+
+bool AbstractInterpretation::reuseLastEvaluation(const ICFGNode* node, const NodeEvalInfo& info)
+{
+    if (!info.evaluated)
+        return false;
+    AbstractState& as = getAbsStateFromTrace(node);
+    auto sameValue = [](const AbstractValue* lhs, const AbstractValue* rhs)
+    {
+        return lhs == rhs || (lhs && rhs && lhs->equals(*rhs));
+    };
+    for (NodeID id : info.uses)
+    {
+        if (!sameValue(as.getVarToVal().lookup(id), info.lastUses.getVarToVal().lookup(id)))
+            return false;
+    }
+    if (info.readsAllMem)
+    {
+        if (!AbstractState::eqVarToValMap(as.getLocToVal(), info.lastUses.getLocToVal()))
+            return false;
+    }
+    else
+    {
+        for (NodeID ptr : info.loadPtrs)
+        {
+            const AbstractValue* ptrVal = as.getVarToVal().lookup(ptr);
+            if (!ptrVal)
+                continue;
+            for (u32_t addr : ptrVal->getAddrs())
+            {
+                u32_t obj = AbstractState::getInternalID(addr);
+                if (!sameValue(as.getLocToVal().lookup(obj), info.lastUses.getLocToVal().lookup(obj)))
+                    return false;
+            }
+        }
+    }
+
+    for (const auto& item : info.changes.getVarToVal())
+        as[item.first] = item.second;
+    for (const auto& item : info.changes.getLocToVal())
+        as.load(AbstractState::getVirtualMemAddress(item.first)) = item.second;
+    return true;
+}
+
+/// The changes are the values of the defs and of the stored memory, and any other value the evaluation changed
+void AbstractInterpretation::recordEvaluation(const ICFGNode* node, NodeEvalInfo& info, const AbstractState& input)
+{
+    const AbstractState& output = getAbsStateFromTrace(node);
+    AbstractState::VarToAbsValMap useVals;
+    AbstractState::AddrToAbsValMap memVals;
+    for (NodeID id : info.uses)
+    {
+        if (const AbstractValue* val = input.getVarToVal().lookup(id))
+            useVals[id] = *val;
+    }
+    if (info.readsAllMem)
+        memVals = input.getLocToVal();
+    else
+    {
+        for (NodeID ptr : info.loadPtrs)
+        {
+            const AbstractValue* ptrVal = input.getVarToVal().lookup(ptr);
+            if (!ptrVal)
+                continue;
+            for (u32_t addr : ptrVal->getAddrs())
+            {
+                u32_t obj = AbstractState::getInternalID(addr);
+                if (const AbstractValue* val = input.getLocToVal().lookup(obj))
+                    memVals[obj] = *val;
+            }
+        }
+    }
+
+    auto collectChanges = [](const AbstractState::VarToAbsValMap& in, const AbstractState::VarToAbsValMap& out,
+                             AbstractState::VarToAbsValMap& changes)
+    {
+        in.forEachDiff(out, [&](const AbstractState::VarToAbsValMap::value_type& item)
+        {
+            const AbstractValue* val = in.lookup(item.first);
+            if (!val || !val->equals(item.second))
+                changes[item.first] = item.second;
+            return true;
+        });
+    };
+    AbstractState::VarToAbsValMap changedVars;
+    AbstractState::AddrToAbsValMap changedLocs;
+    collectChanges(input.getVarToVal(), output.getVarToVal(), changedVars);
+    collectChanges(input.getLocToVal(), output.getLocToVal(), changedLocs);
+    /// a def may keep the value it had, it is written all the same
+    for (NodeID id : info.defs)
+    {
+        if (const AbstractValue* val = output.getVarToVal().lookup(id))
+            changedVars[id] = *val;
+    }
+    for (NodeID ptr : info.storePtrs)
+    {
+        const AbstractValue* ptrVal = output.getVarToVal().lookup(ptr);
+        if (!ptrVal)
+            continue;
+        for (u32_t addr : ptrVal->getAddrs())
+        {
+            u32_t obj = AbstractState::getInternalID(addr);
+            if (const AbstractValue* val = output.getLocToVal().lookup(obj))
+                changedLocs[obj] = *val;
+        }
+    }
+    info.lastUses = AbstractState(useVals, memVals);
+    info.changes = AbstractState(changedVars, changedLocs);
+    info.evaluated = true;
 }
 
 /**
@@ -512,6 +854,178 @@ void AbstractInterpretation::handleWTOComponents(const std::list<const ICFGWTOCo
     }
 }
 
+/*!
+ * Handle the components of a function. With Options::AEEvictStates(), the
+ * state of a node is erased from the trace once the last top-level component
+ * reading it is done, so the trace only holds the states of the current
+ * cycle and of the nodes pending successors still need. The states of call
+ * sites and function exits are read by other functions and are kept.
+ * A function analysed again joins the states its earlier calls left in the
+ * trace, so only the states of functions entered once are evicted and the
+ * results are the same as without eviction.
+ */
+void AbstractInterpretation::handleFunWTOComponents(const CallGraphNode* fun)
+{
+    const std::list<const ICFGWTOComp*>& wtoComps = funcToWTO[fun]->getWTOComponents();
+    if (!Options::AEEvictStates() || !isEnteredOnce(fun))
+    {
+        handleWTOComponents(wtoComps);
+        return;
+    }
+    const std::vector<std::vector<const ICFGNode*>>& plan = getEvictionPlan(fun);
+    u32_t idx = 0;
+    for (const ICFGWTOComp* wtoNode : wtoComps)
+    {
+        handleWTOComponent(wtoNode);
+        for (const ICFGNode* node : plan[idx])
+        {
+            if (abstractTrace.erase(node))
+                stat->getEvictedStates()++;
+        }
+        idx++;
+    }
+}
+
+/*!
+ * A node is read by the components of its successors, which merge its state,
+ * and of the phis taking an operand from it. Its state is needed until the
+ * last of these top-level components and its own one are done; a node in a
+ * cycle is needed until the whole top-level cycle is stable.
+ */
+const std::vector<std::vector<const ICFGNode*>>& AbstractInterpretation::getEvictionPlan(const CallGraphNode* fun)
+{
+    auto it = funToEvictionPlan.find(fun);
+    if (it != funToEvictionPlan.end())
+        return it->second;
+
+    Map<const ICFGNode*, u32_t> nodeToComp;
+    std::vector<const ICFGNode*> nodes;
+    u32_t numOfComps = 0;
+    for (const ICFGWTOComp* comp : funcToWTO[fun]->getWTOComponents())
+    {
+        std::vector<const ICFGWTOComp*> worklist = {comp};
+        while (!worklist.empty())
+        {
+            const ICFGWTOComp* cur = worklist.back();
+            worklist.pop_back();
+            if (const ICFGSingletonWTO* singleton = SVFUtil::dyn_cast<ICFGSingletonWTO>(cur))
+            {
+                nodeToComp[singleton->getICFGNode()] = numOfComps;
+                nodes.push_back(singleton->getICFGNode());
+            }
+            else if (const ICFGCycleWTO* cycle = SVFUtil::dyn_cast<ICFGCycleWTO>(cur))
+            {
+                worklist.push_back(cycle->head());
+                worklist.insert(worklist.end(), cycle->getWTOComponents().begin(), cycle->getWTOComponents().end());
+            }
+        }
+        numOfComps++;
+    }
+
+    Map<const ICFGNode*, u32_t> lastRead = nodeToComp;
+    auto read = [&](const ICFGNode* node, u32_t comp)
+    {
+        auto readIt = lastRead.find(node);
+        if (readIt != lastRead.end() && readIt->second < comp)
+            readIt->second = comp;
+    };
+    for (const ICFGNode* node : nodes)
+    {
+        u32_t comp = nodeToComp[node];
+        for (const ICFGEdge* edge : node->getInEdges())
+            read(edge->getSrcNode(), comp);
+        for (const ICFGNode* subNode : icfg->getSubNodes(node))
+        {
+            for (const SVFStmt* stmt : subNode->getSVFStmts())
+            {
+                if (const PhiStmt* phi = SVFUtil::dyn_cast<PhiStmt>(stmt))
+                {
+                    for (u32_t i = 0; i < phi->getOpVarNum(); i++)
+                        read(icfg->getRepNode(phi->getOpICFGNode(i)), comp);
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<const ICFGNode*>>& plan = funToEvictionPlan[fun];
+    plan.resize(numOfComps);
+    for (const ICFGNode* node : nodes)
+    {
+        if (SVFUtil::isa<CallICFGNode>(node) || SVFUtil::isa<FunExitICFGNode>(node))
+            continue;
+        plan[lastRead[node]].push_back(node);
+    }
+    return plan;
+}
+
+/*!
+ * A function is entered once if it is not recursive, its address is not taken
+ * (no indirect call may reach it), and it has no caller or a single direct
+ * call site, outside any cycle of a caller which is itself entered once.
+ */
+bool AbstractInterpretation::isEnteredOnce(const CallGraphNode* fun)
+{
+    auto it = funToEnteredOnce.find(fun);
+    if (it != funToEnteredOnce.end())
+        return it->second;
+    /// assume not while deciding, which also covers cycles of callers
+    funToEnteredOnce[fun] = false;
+
+    bool once = recursiveFuns.find(fun) == recursiveFuns.end();
+    if (once)
+    {
+        SymbolTableInfo::ValueToIDMapTy& objSyms = svfir->getSymbolInfo()->objSyms();
+        auto symIt = objSyms.find(fun->getFunction()->getDefFunForMultipleModule());
+        once = symIt != objSyms.end() && svfir->hasGNode(symIt->second) &&
+               !svfir->getGNode(symIt->second)->hasOutgoingEdge();
+    }
+    if (once)
+    {
+        std::vector<const CallICFGNode*> callSites;
+        for (const CallGraphEdge* edge : fun->getInEdges())
+            callSites.insert(callSites.end(), edge->directCallsBegin(), edge->directCallsEnd());
+        if (callSites.size() > 1)
+            once = false;
+        else if (callSites.size() == 1)
+        {
+            const CallGraphNode* caller = svfir->getCallGraph()->getCallGraphNode(callSites[0]->getCaller());
+            once = isEnteredOnce(caller) && !isInCycle(caller, icfg->getRepNode(callSites[0]));
+        }
+    }
+    funToEnteredOnce[fun] = once;
+    return once;
+}
+
+/// Whether a node of a function is in a cycle of its WTO, i.e., may be handled more than once
+bool AbstractInterpretation::isInCycle(const CallGraphNode* fun, const ICFGNode* node) const
+{
+    auto it = funcToWTO.find(fun);
+    if (it == funcToWTO.end())
+        return true;
+    for (const ICFGWTOComp* comp : it->second->getWTOComponents())
+    {
+        if (!SVFUtil::isa<ICFGCycleWTO>(comp))
+            continue;
+        std::vector<const ICFGWTOComp*> worklist = {comp};
+        while (!worklist.empty())
+        {
+            const ICFGWTOComp* cur = worklist.back();
+            worklist.pop_back();
+            if (const ICFGSingletonWTO* singleton = SVFUtil::dyn_cast<ICFGSingletonWTO>(cur))
+            {
+                if (singleton->getICFGNode() == node)
+                    return true;
+            }
+            else if (const ICFGCycleWTO* cycle = SVFUtil::dyn_cast<ICFGCycleWTO>(cur))
+            {
+                worklist.push_back(cycle->head());
+                worklist.insert(worklist.end(), cycle->getWTOComponents().begin(), cycle->getWTOComponents().end());
+            }
+        }
+    }
+    return false;
+}
+
 void AbstractInterpretation::handleWTOComponent(const SVF::ICFGWTOComp* wtoNode)
 {
     if (const ICFGSingletonWTO* node = SVFUtil::dyn_cast<ICFGSingletonWTO>(wtoNode))
@@ -623,8 +1137,7 @@ void AbstractInterpretation::directCallFunPass(const SVF::CallICFGNode *callNode
     abstractTrace[callNode] = as;
 
     const SVFFunction *callfun =callNode->getCalledFunction();
-    ICFGWTO* wto = funcToWTO[callfun->getCallGraphNode()];
-    handleWTOComponents(wto->getWTOComponents());
+    handleCallee(callfun->getCallGraphNode());
 
     callSiteStack.pop_back();
     // handle Ret node
@@ -657,8 +1170,7 @@ void AbstractInterpretation::indirectCallFunPass(const SVF::CallICFGNode *callNo
         callSiteStack.push_back(callNode);
         abstractTrace[callNode] = as;
 
-        ICFGWTO* wto = funcToWTO[callfun];
-        handleWTOComponents(wto->getWTOComponents());
+        handleCallee(callfun);
         callSiteStack.pop_back();
         // handle Ret node
         const RetICFGNode* retNode = callNode->getRetICFGNode();
@@ -666,7 +1178,252 @@ void AbstractInterpretation::indirectCallFunPass(const SVF::CallICFGNode *callNo
     }
 }
 
+/*!
+ * Analyse a callee, or reuse one of its summaries. The key of a summary is the
+ * entry state restricted to the parameters and to the memory reachable from
+ * them and from global variables, including every field and element of a
+ * reachable object, i.e., what the callee may read. A summary
+ * is reused if its input is the same as the current one or subsumes it, and
+ * so do the entry values of the other locations it wrote, e.g., of an object
+ * the callee allocates; its output then overrides the current entry state to
+ * give the exit state.
+ * Detectors and checkpoints are not run again on a reused summary, the bugs of
+ * the callee were reported when its summary was computed with a larger input.
+ */
+void AbstractInterpretation::handleCallee(const CallGraphNode* callee)
+{
+    const FunEntryICFGNode* entry = icfg->getFunEntryICFGNode(callee->getFunction());
+    const FunExitICFGNode* exit = icfg->getFunExitICFGNode(callee->getFunction());
+    if (Options::AESummaryLimit() == 0 || !mergeStatesFromPredecessors(entry))
+    {
+        handleFunWTOComponents(callee);
+        return;
+    }
+
+    AbstractState entryAs = abstractTrace[entry];
+    AbstractState input = getSummaryInput(entry, entryAs);
+    u64_t hash = hashSummaryInput(input);
+    if (const FunSummary* summary = findSummary(callee, input, hash, entryAs))
+    {
+        AbstractState exitAs = entryAs;
+        for (const auto& item : summary->output.getVarToVal())
+            exitAs[item.first] = item.second;
+        for (const auto& item : summary->output.getLocToVal())
+            exitAs.load(AbstractState::getVirtualMemAddress(item.first)) = item.second;
+        abstractTrace[exit] = exitAs;
+        return;
+    }
+
+    stat->getSummaryMisses()++;
+    /// an exit state left by an earlier call is not a result of this one
+    abstractTrace.erase(exit);
+    handleFunWTOComponents(callee);
+    auto it = abstractTrace.find(exit);
+    if (it == abstractTrace.end())
+        return;
+
+    std::deque<FunSummary>& summaries = funToSummaries[callee];
+    if (summaries.size() >= Options::AESummaryLimit())
+        summaries.pop_front();
+    AbstractState output = getSummaryOutput(exit, input, entryAs, it->second);
+    AbstractState writtenEntry = getWrittenEntry(input, output, entryAs);
+    summaries.push_back({hash, std::move(input), std::move(output), std::move(writtenEntry)});
+}
+
+AbstractState AbstractInterpretation::getSummaryInput(const FunEntryICFGNode* entry, const AbstractState& entryAs)
+{
+    if (!globalObjsCollected)
+    {
+        for (const auto& item : abstractTrace[icfg->getGlobalICFGNode()].getVarToVal())
+        {
+            for (u32_t addr : item.second.getAddrs())
+                globalObjs.insert(AbstractState::getInternalID(addr));
+        }
+        globalObjsCollected = true;
+    }
 
+    /// an address of an object lets the callee reach all of its fields and elements
+    Map<NodeID, std::vector<u32_t>> baseToLocs;
+    for (const auto& item : entryAs.getLocToVal())
+    {
+        if (!svfir->hasGNode(item.first))
+            continue;
+        if (const ObjVar* objVar = SVFUtil::dyn_cast<ObjVar>(svfir->getGNode(item.first)))
+            baseToLocs[objVar->getMemObj()->getId()].push_back(item.first);
+    }
+
+    AbstractState::VarToAbsValMap vars;
+    AbstractState::AddrToAbsValMap locs;
+    std::vector<u32_t> worklist(globalObjs.begin(), globalObjs.end());
+    for (const SVFVar* param : entry->getFormalParms())
+    {
+        auto it = entryAs.getVarToVal().find(param->getId());
+        if (it == entryAs.getVarToVal().end())
+            continue;
+        vars[param->getId()] = it->second;
+        for (u32_t addr : it->second.getAddrs())
+            worklist.push_back(AbstractState::getInternalID(addr));
+    }
+    Set<NodeID> visitedBases;
+    while (!worklist.empty())
+    {
+        u32_t obj = worklist.back();
+        worklist.pop_back();
+        const ObjVar* objVar = svfir->hasGNode(obj) ? SVFUtil::dyn_cast<ObjVar>(svfir->getGNode(obj)) : nullptr;
+        if (objVar)
+        {
+            NodeID base = objVar->getMemObj()->getId();
+            if (visitedBases.insert(base).second)
+            {
+                auto fields = baseToLocs.find(base);
+                if (fields != baseToLocs.end())
+                    worklist.insert(worklist.end(), fields->second.begin(), fields->second.end());
+            }
+        }
+        auto it = entryAs.getLocToVal().find(obj);
+        if (it == entryAs.getLocToVal().end() || locs.count(obj))
+            continue;
+        locs[obj] = it->second;
+        for (u32_t addr : it->second.getAddrs())
+            worklist.push_back(AbstractState::getInternalID(addr));
+    }
+    return AbstractState(vars, locs);
+}
+
+/*!
+ * The part of the exit state a caller may observe and the callee may have
+ * written: the return value, the reachable memory of the input, and every
+ * other variable or object whose entry differs from the entry state, even if
+ * it was written with the value it already had.
+ */
+AbstractState AbstractInterpretation::getSummaryOutput(const FunExitICFGNode* exit, const AbstractState& input,
+        const AbstractState& entryAs, const AbstractState& exitAs) const
+{
+    AbstractState::VarToAbsValMap vars;
+    AbstractState::AddrToAbsValMap locs;
+    entryAs.getVarToVal().forEachDiff(exitAs.getVarToVal(), [&](const AbstractState::VarToAbsValMap::value_type& item)
+    {
+        vars[item.first] = item.second;
+        return true;
+    });
+    if (const SVFVar* ret = exit->getFormalRet())
+    {
+        auto it = exitAs.getVarToVal().find(ret->getId());
+        if (it != exitAs.getVarToVal().end())
+            vars[ret->getId()] = it->second;
+    }
+    entryAs.getLocToVal().forEachDiff(exitAs.getLocToVal(), [&](const AbstractState::AddrToAbsValMap::value_type& item)
+    {
+        locs[item.first] = item.second;
+        return true;
+    });
+    for (const auto& item : input.getLocToVal())
+    {
+        auto it = exitAs.getLocToVal().find(item.first);
+        if (it != exitAs.getLocToVal().end())
+            locs[item.first] = it->second;
+    }
+    return AbstractState(vars, locs);
+}
+
+/// Entry values of the locations written by a callee outside its input
+AbstractState AbstractInterpretation::getWrittenEntry(const AbstractState& input, const AbstractState& output,
+        const AbstractState& entryAs)
+{
+    AbstractState::VarToAbsValMap vars;
+    AbstractState::AddrToAbsValMap locs;
+    for (const auto& item : output.getLocToVal())
+    {
+        if (input.getLocToVal().count(item.first))
+            continue;
+        auto it = entryAs.getLocToVal().find(item.first);
+        if (it != entryAs.getLocToVal().end())
+            locs[item.first] = it->second;
+    }
+    return AbstractState(vars, locs);
+}
+
+const AbstractInterpretation::FunSummary* AbstractInterpretation::findSummary(const CallGraphNode* callee,
+        const AbstractState& input, u64_t hash, const AbstractState& entryAs)
+{
+    auto it = funToSummaries.find(callee);
+    if (it == funToSummaries.end())
+        return nullptr;
+    for (const FunSummary& summary : it->second)
+    {
+        if (summary.hash == hash && summary.input == input &&
+                summary.writtenEntry == getWrittenEntry(summary.input, summary.output, entryAs))
+        {
+            stat->getSummaryHits()++;
+            return &summary;
+        }
+    }
+    for (const FunSummary& summary : it->second)
+    {
+        if (subsumes(summary.input, input) &&
+                subsumes(summary.writtenEntry, getWrittenEntry(summary.input, summary.output, entryAs)))
+        {
+            stat->getSummaryHits()++;
+            stat->getSubsumedSummaryHits()++;
+            return &summary;
+        }
+    }
+    return nullptr;
+}
+
+/// Hash of an input, independent of the iteration order of its maps
+u64_t AbstractInterpretation::hashSummaryInput(const AbstractState& input)
+{
+    auto hashValue = [](u32_t key, const AbstractValue& val)
+    {
+        u64_t h = (u64_t)key * 0x9E3779B97F4A7C15ULL;
+        const IntervalValue itv = val.getInterval();
+        if (!itv.isBottom())
+        {
+            h ^= (u64_t)itv.lb().getNumeral() * 0xC2B2AE3D27D4EB4FULL;
+            h ^= (u64_t)itv.ub().getNumeral() * 0x165667B19E3779F9ULL;
+        }
+        for (u32_t addr : val.getAddrs())
+            h += (u64_t)addr * 0x27D4EB2F165667C5ULL;
+        return h ^ (h >> 29);
+    };
+    u64_t hash = 0;
+    for (const auto& item : input.getVarToVal())
+        hash += hashValue(item.first, item.second);
+    for (const auto& item : input.getLocToVal())
+        hash += hashValue(~item.first, item.second);
+    return hash;
+}
+
+/// Whether every value of rhs is contained in the value of lhs, a missing value is bottom
+bool AbstractInterpretation::subsumes(const AbstractState& lhs, const AbstractState& rhs)
+{
+    auto contains = [](const AbstractState::VarToAbsValMap& lhsMap, const AbstractState::VarToAbsValMap& rhsMap)
+    {
+        for (const auto& item : rhsMap)
+        {
+            auto it = lhsMap.find(item.first);
+            if (it == lhsMap.end())
+            {
+                if (!item.second.getInterval().isBottom() || !item.second.getAddrs().isBottom())
+                    return false;
+                continue;
+            }
+            if (!item.second.getInterval().containedWithin(it->second.getInterval()))
+                return false;
+            const AddressValue lhsAddrs = it->second.getAddrs();
+            if (!lhsAddrs.isBottom() && lhsAddrs.isTop())
+                continue;
+            for (u32_t addr : item.second.getAddrs())
+            {
+                if (!lhsAddrs.contains(addr))
+                    return false;
+            }
+        }
+        return true;
+    };
+    return contains(lhs.getVarToVal(), rhs.getVarToVal()) && contains(lhs.getLocToVal(), rhs.getLocToVal());
+}
 
 /// handle wto cycle (loop)
 void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
@@ -876,6 +1633,9 @@ void AEStat::finializeStat()
     generalNumMap["Func_Num"] = funs.size();
     generalNumMap["EXT_CallSite_Num"] = extCallSiteNum;
     generalNumMap["NonEXT_CallSite_Num"] = callSiteNum;
+    u32_t summaryLookups = getSummaryHits() + getSummaryMisses();
+    if (summaryLookups > 0)
+        generalNumMap["Summary_Hit_Rate(%)"] = getSummaryHits() * 100 / summaryLookups;
     timeStatMap["Total_Time(sec)"] = (double)(endTime - startTime) / TIMEINTERVAL;
 
 }
@@ -74,9 +74,11 @@ void ContextDDA::initialize()
  */
 const CxtPtSet& ContextDDA::computeDDAPts(const CxtVar& var)
 {
+    if (queryCache && answerFromQueryCache(var))
+        return this->getPts(var);
 
     resetQuery();
-    LocDPItem::setMaxBudget(Options::CxtBudget());
+    LocDPItem::setMaxBudget(queryBudget ? queryBudget : Options::CxtBudget());
 
     NodeID id = var.get_id();
     PAGNode* node = getPAG()->getGNode(id);
@@ -93,6 +95,9 @@ const CxtPtSet& ContextDDA::computeDDAPts(const CxtVar& var)
     else
         handleOutOfBudgetDpm(dpm);
 
+    if (queryCache)
+        addToQueryCache(var);
+
     if (this->printStat())
         DOSTAT(stat->performStatPerQuery(id));
     DBOUT(DGENERAL, stat->printStatPerQuery(id,getBVPointsTo(getPts(var))));
@@ -109,6 +114,111 @@ void ContextDDA::computeDDAPts(NodeID id)
     computeDDAPts(var);
 }
 
+/*!
+ * Estimate the cost of a query from the SVFG nodes it may traverse backward. Nodes on
+ * value-flow cycles are counted twice as they are recomputed. The count stops at the
+ * context budget to bound the estimation itself; it only orders queries, whether a
+ * query fits in the budget is decided by running it.
+ */
+u32_t ContextDDA::estimateQueryCost(NodeID id)
+{
+    if (getSVFGSCC() == nullptr)
+        SVFGSCCDetection();
+
+    u32_t budget = Options::CxtBudget();
+    u32_t cost = 0;
+    const SVFGNode* def = getDefSVFGNode(getPAG()->getGNode(id));
+    Set<const SVFGNode*> visited;
+    FIFOWorkList<const SVFGNode*> worklist;
+    visited.insert(def);
+    worklist.push(def);
+    while (!worklist.empty() && cost < budget)
+    {
+        const SVFGNode* node = worklist.pop();
+        cost += isSVFGNodeInCycle(node) ? 2 : 1;
+        for (const SVFGEdge* edge : node->getInEdges())
+        {
+            if (visited.insert(edge->getSrcNode()).second)
+                worklist.push(edge->getSrcNode());
+        }
+    }
+    return std::min(cost, budget);
+}
+
+/*!
+ * Answer a query with the context-insensitive flowDDA first. Its answer is kept when context
+ * refinement cannot help (at most one object); otherwise the query is refined within the
+ * context budget, which falls back to this answer if the budget runs out.
+ */
+ContextDDA::QuerySchedule ContextDDA::computeFlowPtsFirst(NodeID id)
+{
+    flowDDA->computeDDAPts(id);
+    const PointsTo& flowPts = flowDDA->getPts(id);
+
+    QuerySchedule schedule = RefineWithContext;
+    if (flowPts.count() <= 1)
+        schedule = KeepFlowSingleton;
+
+    if (schedule != RefineWithContext)
+    {
+        ContextCond cxt;
+        CxtVar var(cxt, id);
+        CxtPtSet cpts;
+        for (NodeID obj : flowPts)
+            cpts.set(CxtVar(cxt, obj));
+        unionPts(var, cpts);
+    }
+    return schedule;
+}
+
+const PointsTo& ContextDDA::getFlowPts(NodeID id)
+{
+    return flowDDA->getPts(id);
+}
+
+PointsTo ContextDDA::getEmptyCxtPts(NodeID id)
+{
+    ContextCond cxt;
+    return getBVPointsTo(getPts(CxtVar(cxt, id)));
+}
+
+/*!
+ * Answer a query with the points-to cached by a previous run, return false if it has to be computed
+ */
+bool ContextDDA::answerFromQueryCache(const CxtVar& var)
+{
+    const DDAQueryCache::CachedPts* cached = queryCache->getCachedPts(std::make_pair(var.get_id(), var.get_cond().getContexts()));
+    if (cached == nullptr)
+        return false;
+
+    CxtPtSet cpts;
+    for (const DDAQueryCache::CachedVar& obj : *cached)
+    {
+        ContextCond cxt;
+        cxt.getContexts() = obj.second;
+        cpts.set(CxtVar(cxt, obj.first));
+    }
+    unionPts(var, cpts);
+    ddaStat->_NumOfQueryCacheHit++;
+    return true;
+}
+
+/*!
+ * Record the answer of the current query, out-of-budget answers depend on the budget and are not kept
+ */
+void ContextDDA::addToQueryCache(const CxtVar& var)
+{
+    addQueryCacheDependences();
+    if (isOutOfBudgetQuery())
+        return;
+
+    DDAQueryCache::CachedPts pts;
+    const CxtPtSet& cpts = this->getPts(var);
+    for (CxtPtSet::const_iterator it = cpts.begin(), eit = cpts.end(); it != eit; ++it)
+        pts.push_back(std::make_pair(it->get_id(), it->get_cond().getContexts()));
+    queryCache->addCachedPts(std::make_pair(var.get_id(), var.get_cond().getContexts()), pts);
+}
+
 /*!
  * Handle out-of-budget dpm
  */
@@ -130,6 +240,22 @@ void ContextDDA::handleOutOfBudgetDpm(const CxtLocDPItem& dpm)
     addOutOfBudgetDpm(dpm);
 }
 
+/*!
+ * Take over points-to of the queries answered by worker, the indirect calls it
+ * resolved and its statistics
+ */
+void ContextDDA::mergeQueryResults(ContextDDA* worker, const std::vector<NodeID>& queries)
+{
+    for (NodeID id : queries)
+    {
+        ContextCond cxt;
+        CxtVar var(cxt, id);
+        unionPts(var, worker->getPts(var));
+    }
+    mergeIndirectCalls(worker->getIndCallMap());
+    ddaStat->mergeStat(*worker->ddaStat);
+}
+
 /*!
  * context conditions of local(not in recursion)  and global variables are compatible
  */
@@ -36,8 +36,11 @@
 
 #include "DDA/DDAClient.h"
 #include "DDA/FlowDDA.h"
+#include "DDA/ContextDDA.h"
 #include <iostream>
 #include <iomanip>	// for std::setw
+#include <atomic>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -54,6 +57,15 @@ void DDAClient::answerQueries(PointerAnalysis* pta)
 
     collectCandidateQueries(pta->getPAG());
 
+    if (Options::DDAAdaptive() && pta->getAnalysisTy() == PointerAnalysis::Cxt_DDA)
+    {
+        answerQueriesByCost(static_cast<ContextDDA*>(pta));
+        vmrss = vmsize = 0;
+        SVFUtil::getMemoryUsageKB(&vmrss, &vmsize);
+        stat->setMemUsageAfter(vmrss, vmsize);
+        return;
+    }
+
     u32_t count = 0;
     for (OrderedNodeSet::iterator nIter = candidateQueries.begin();
             nIter != candidateQueries.end(); ++nIter,++count)
@@ -66,7 +78,9 @@ void DDAClient::answerQueries(PointerAnalysis* pta)
             DBOUT(DDDA,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
                   " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
             setCurrentQueryPtr(node->getId());
+            double start = DDAStat::getClk(true);
             pta->computeDDAPts(node->getId());
+            stat->addQueryLatency(DDAStat::getClk(true) - start);
         }
     }
 
@@ -75,6 +89,151 @@ void DDAClient::answerQueries(PointerAnalysis* pta)
     stat->setMemUsageAfter(vmrss, vmsize);
 }
 
+/*!
+ * Answer the cheapest queries first. All queries get a context-insensitive pass first; the
+ * context budget is then spent, cheapest first, only on those whose answer it may refine;
+ * a query running out of it keeps its flow-sensitive answer.
+ */
+void DDAClient::answerQueriesByCost(ContextDDA* pta)
+{
+    DDAStat* stat = static_cast<DDAStat*>(pta->getStat());
+
+    std::vector<std::pair<u32_t, NodeID>> queries;
+    for (NodeID id : candidateQueries)
+    {
+        if (pta->getPAG()->isValidTopLevelPtr(pta->getPAG()->getGNode(id)))
+            queries.push_back(std::make_pair(pta->estimateQueryCost(id), id));
+    }
+    std::stable_sort(queries.begin(), queries.end());
+
+    std::vector<ContextDDA::QuerySchedule> schedules;
+    std::vector<u32_t> flowPtsSizes;
+    std::vector<double> times;
+    for (const std::pair<u32_t, NodeID>& query : queries)
+    {
+        setCurrentQueryPtr(query.second);
+        double start = DDAStat::getClk(true);
+        schedules.push_back(pta->computeFlowPtsFirst(query.second));
+        times.push_back(DDAStat::getClk(true) - start);
+        flowPtsSizes.push_back(pta->getFlowPts(query.second).count());
+    }
+
+    for (u32_t i = 0; i < queries.size(); ++i)
+    {
+        if (schedules[i] != ContextDDA::RefineWithContext)
+            continue;
+        DBOUT(DGENERAL,outs() << "\n@@Refining PointsTo for :" << queries[i].second << " (cost " << queries[i].first << ")\n");
+        setCurrentQueryPtr(queries[i].second);
+        double start = DDAStat::getClk(true);
+        pta->computeDDAPts(queries[i].second);
+        times[i] += DDAStat::getClk(true) - start;
+        if (pta->isOutOfBudgetQuery())
+            schedules[i] = ContextDDA::FellBackOutOfBudget;
+    }
+
+    static const std::string scheduleNames[] = {"refined", "flow-singleton", "out-of-budget"};
+    for (u32_t i = 0; i < queries.size(); ++i)
+    {
+        stat->addQueryLatency(times[i]);
+        stat->addQueryProfile(queries[i].second, queries[i].first, scheduleNames[schedules[i]],
+                              flowPtsSizes[i], pta->getEmptyCxtPts(queries[i].second).count(), times[i]);
+    }
+    if (!Options::DDAQueryProfile().empty())
+        stat->writeQueryProfile(Options::DDAQueryProfile());
+}
+
+/*!
+ * Every solver of the pool owns its SVFG, call graph and dpm caches, which it refines
+ * while answering queries; the SVFIR and the Andersen pre-analysis are shared read-only.
+ * The pre-analysis over-approximates the demand-driven results, so the field objects and
+ * call site IDs a solver asks for have already been created by it.
+ * Queries are handed out one at a time in batches. Between batches, every solver connects
+ * the indirect calls resolved by the others, so later queries see them; results and
+ * statistics of the workers are merged into pta once all queries are answered.
+ */
+void DDAClient::answerQueriesInParallel(PointerAnalysis* pta, const std::vector<PointerAnalysis*>& workers)
+{
+    DDAStat* stat = static_cast<DDAStat*>(pta->getStat());
+    u32_t vmrss = 0;
+    u32_t vmsize = 0;
+    SVFUtil::getMemoryUsageKB(&vmrss, &vmsize);
+    stat->setMemUsageBefore(vmrss, vmsize);
+
+    collectCandidateQueries(pta->getPAG());
+
+    std::vector<NodeID> queries;
+    for (NodeID id : candidateQueries)
+    {
+        if (pta->getPAG()->isValidTopLevelPtr(pta->getPAG()->getGNode(id)))
+            queries.push_back(id);
+    }
+
+    /// Solvers share Andersen's analysis and fall back to its points-to sets. A lookup
+    /// inserts a missing pointer into the mutable backing, so do all lookups up front.
+    AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(pta->getPAG());
+    for (const auto& it : *pta->getPAG())
+        ander->getPts(it.first);
+
+    std::vector<PointerAnalysis*> pool(1, pta);
+    pool.insert(pool.end(), workers.begin(), workers.end());
+    std::vector<std::vector<NodeID>> answered(pool.size());
+    std::atomic<size_t> nextQuery(0);
+
+    auto mergeIndirectCalls = [&](PointerAnalysis* solver, PointerAnalysis* other)
+    {
+        if (pta->getAnalysisTy() == PointerAnalysis::Cxt_DDA)
+            static_cast<ContextDDA*>(solver)->mergeIndirectCalls(other->getIndCallMap());
+        else
+            static_cast<FlowDDA*>(solver)->mergeIndirectCalls(other->getIndCallMap());
+    };
+
+    /// 64 queries per solver between two sync points
+    const size_t batchSize = pool.size() * 64;
+    for (size_t batchBegin = 0; batchBegin < queries.size(); batchBegin += batchSize)
+    {
+        const size_t batchEnd = std::min(queries.size(), batchBegin + batchSize);
+        nextQuery = batchBegin;
+        std::vector<std::thread> threads;
+        for (u32_t t = 0; t < pool.size(); ++t)
+        {
+            threads.push_back(std::thread([&, t]()
+            {
+                DDAStat* solverStat = static_cast<DDAStat*>(pool[t]->getStat());
+                for (size_t i = nextQuery++; i < batchEnd; i = nextQuery++)
+                {
+                    DBOUT(DGENERAL,outs() << "\n@@Computing PointsTo for :" << queries[i] <<
+                          " [" << i + 1 << "/" << queries.size() << "]" << " \n");
+                    double start = DDAStat::getClk(true);
+                    pool[t]->computeDDAPts(queries[i]);
+                    solverStat->addQueryLatency(DDAStat::getClk(true) - start);
+                    answered[t].push_back(queries[i]);
+                }
+            }));
+        }
+        for (std::thread &thread : threads) thread.join();
+
+        if (batchEnd == queries.size())
+            break;
+        /// sync point: share the call graph edges discovered by this batch
+        for (u32_t t = 1; t < pool.size(); ++t)
+            mergeIndirectCalls(pta, pool[t]);
+        for (u32_t t = 1; t < pool.size(); ++t)
+            mergeIndirectCalls(pool[t], pta);
+    }
+
+    for (u32_t t = 1; t < pool.size(); ++t)
+    {
+        if (pta->getAnalysisTy() == PointerAnalysis::Cxt_DDA)
+            static_cast<ContextDDA*>(pta)->mergeQueryResults(static_cast<ContextDDA*>(pool[t]), answered[t]);
+        else
+            static_cast<FlowDDA*>(pta)->mergeQueryResults(static_cast<FlowDDA*>(pool[t]), answered[t]);
+    }
+
+    vmrss = vmsize = 0;
+    SVFUtil::getMemoryUsageKB(&vmrss, &vmsize);
+    stat->setMemUsageAfter(vmrss, vmsize);
+}
+
 OrderedNodeSet& FunptrDDAClient::collectCandidateQueries(SVFIR* p)
 {
     setPAG(p);
@@ -34,9 +34,16 @@
 #include "DDA/FlowDDA.h"
 #include "DDA/ContextDDA.h"
 #include "DDA/DDAClient.h"
+#include "Graphs/CallGraph.h"
 
 #include <sstream>
+#include <iostream>
 #include <limits.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -137,8 +144,39 @@ void DDAPass::runPointerAnalysis(SVFIR* pag, u32_t kind)
     {
         ///initialize
         _pta->initialize();
+        std::unique_ptr<DDAQueryCache> queryCache;
+        if (!Options::DDAQueryCache().empty())
+        {
+            /// the singleton Andersen's analysis the solver has built its SVFG with
+            queryCache = std::make_unique<DDAQueryCache>(pag, _pta->getCallGraph(), AndersenWaveDiff::createAndersenWaveDiff(pag));
+            queryCache->readFromFile(Options::DDAQueryCache());
+            if (kind == PointerAnalysis::Cxt_DDA)
+                static_cast<ContextDDA*>(_pta.get())->setQueryCache(queryCache.get());
+            else
+                static_cast<FlowDDA*>(_pta.get())->setQueryCache(queryCache.get());
+        }
         ///compute points-to
-        _client->answerQueries(_pta.get());
+        if (!Options::DDAServer().empty())
+            serveQueries(Options::DDAServer());
+        else if (Options::DDAThreads() > 1)
+        {
+            std::vector<std::unique_ptr<PointerAnalysis>> pool;
+            std::vector<PointerAnalysis*> workers;
+            for (u32_t i = 1; i < Options::DDAThreads(); ++i)
+            {
+                if (kind == PointerAnalysis::Cxt_DDA)
+                    pool.push_back(std::make_unique<ContextDDA>(pag, _client));
+                else
+                    pool.push_back(std::make_unique<FlowDDA>(pag, _client));
+                pool.back()->initialize();
+                workers.push_back(pool.back().get());
+            }
+            _client->answerQueriesInParallel(_pta.get(), workers);
+        }
+        else
+            _client->answerQueries(_pta.get());
+        if (queryCache)
+            queryCache->writeToFile(Options::DDAQueryCache());
         ///finalize
         _pta->finalize();
         if(Options::PrintCPts())
@@ -331,3 +369,265 @@ void DDAPass::printQueryPTS()
         _pta->dumpPts(*it,pts);
     }
 }
+
+/*!
+ * Override the step budget of the solver for the following queries
+ */
+void DDAPass::setQueryBudget(u32_t budget)
+{
+    if (_pta->getAnalysisTy() == PointerAnalysis::Cxt_DDA)
+        static_cast<ContextDDA*>(_pta.get())->setQueryBudget(budget);
+    else
+        static_cast<FlowDDA*>(_pta.get())->setQueryBudget(budget);
+}
+
+/*!
+ * Points-to of a pointer in the empty context. ContextDDA merges the points-to of its
+ * context-sensitive variables only in finalize(), so it is read from the solver directly.
+ */
+PointsTo DDAPass::queryPts(NodeID id)
+{
+    if (_pta->getAnalysisTy() == PointerAnalysis::Cxt_DDA)
+    {
+        ContextDDA* cxtDDA = static_cast<ContextDDA*>(_pta.get());
+        ContextCond cxt;
+        return cxtDDA->getBVPointsTo(cxtDDA->computeDDAPts(CxtVar(cxt, id)));
+    }
+    _pta->computeDDAPts(id);
+    return _pta->getPts(id);
+}
+
+/*!
+ * Alias of two variables in the empty context, see queryPts
+ */
+AliasResult DDAPass::queryAlias(NodeID id1, NodeID id2)
+{
+    if (_pta->getAnalysisTy() != PointerAnalysis::Cxt_DDA)
+        return alias(id1, id2);
+
+    SVFIR* pag = _pta->getPAG();
+    ContextDDA* cxtDDA = static_cast<ContextDDA*>(_pta.get());
+    ContextCond cxt;
+    CxtVar var1(cxt, id1), var2(cxt, id2);
+    if (pag->isValidTopLevelPtr(pag->getGNode(id1)))
+        cxtDDA->computeDDAPts(var1);
+    if (pag->isValidTopLevelPtr(pag->getGNode(id2)))
+        cxtDDA->computeDDAPts(var2);
+    return cxtDDA->alias(var1, var2);
+}
+
+/*!
+ * Answer one request of the line-oriented server protocol
+ *   pts <ptr> [budget]             -> ok <obj>*
+ *   alias <ptr> <ptr> [budget]     -> ok NoAlias|MayAlias|MustAlias|PartialAlias
+ *   callees <callsite> [budget]    -> ok <function>*
+ *   quit                           -> ends the session
+ *   shutdown                       -> ends the session and stops the server
+ * A budget overrides -cxt-bg/-flow-bg for that request only. Points-to and dpm caches of
+ * the solver are kept across requests with the same budget; they are dropped when the
+ * budget changes after some query ran out of budget, so a conservative answer is only
+ * reused under the budget that produced it.
+ */
+bool DDAPass::answerRequest(const std::string& request, std::string& reply)
+{
+    std::istringstream ss(request);
+    std::ostringstream rs;
+    std::string cmd;
+    reply.clear();
+    if (!(ss >> cmd))
+        return true;
+    if (cmd == "quit")
+        return false;
+    if (cmd == "shutdown")
+    {
+        _serverShutdown = true;
+        return false;
+    }
+
+    SVFIR* pag = _pta->getPAG();
+    NodeID id = 0, id2 = 0;
+    u32_t budget = 0;
+    if (cmd == "pts")
+    {
+        if (!(ss >> id) || !pag->hasGNode(id) || !pag->isValidTopLevelPtr(pag->getGNode(id)))
+        {
+            reply = "error pts expects a top-level pointer id";
+            return true;
+        }
+        ss >> budget;
+        setQueryBudget(budget);
+        rs << "ok";
+        for (NodeID obj : queryPts(id))
+            rs << " " << obj;
+    }
+    else if (cmd == "alias")
+    {
+        if (!(ss >> id >> id2) || !pag->hasGNode(id) || !pag->hasGNode(id2))
+        {
+            reply = "error alias expects two variable ids";
+            return true;
+        }
+        ss >> budget;
+        setQueryBudget(budget);
+        switch (queryAlias(id, id2))
+        {
+        case AliasResult::NoAlias:
+            rs << "ok NoAlias";
+            break;
+        case AliasResult::MustAlias:
+            rs << "ok MustAlias";
+            break;
+        case AliasResult::PartialAlias:
+            rs << "ok PartialAlias";
+            break;
+        default:
+            rs << "ok MayAlias";
+            break;
+        }
+    }
+    else if (cmd == "callees")
+    {
+        ICFG* icfg = pag->getICFG();
+        const CallICFGNode* cs = nullptr;
+        if ((ss >> id) && icfg->hasGNode(id))
+            cs = SVFUtil::dyn_cast<CallICFGNode>(icfg->getGNode(id));
+        if (cs == nullptr)
+        {
+            reply = "error callees expects a call site ICFG node id";
+            return true;
+        }
+        ss >> budget;
+        setQueryBudget(budget);
+        PTACallGraph::FunctionSet callees;
+        if (pag->isIndirectCallSites(cs))
+        {
+            for (NodeID obj : queryPts(pag->getFunPtr(cs)))
+            {
+                const ObjVar* objVar = SVFUtil::dyn_cast<ObjVar>(pag->getGNode(obj));
+                if (objVar == nullptr || !pag->getObject(objVar)->isFunction())
+                    continue;
+                const SVFFunction* callee = SVFUtil::cast<CallGraphNode>(pag->getObject(objVar)->getGNode())->getFunction();
+                callee = callee->getDefFunForMultipleModule();
+                if (SVFUtil::matchArgs(cs, callee))
+                    callees.insert(callee);
+            }
+        }
+        else
+            _pta->getCallGraph()->getCallees(cs, callees);
+        rs << "ok";
+        for (const SVFFunction* callee : callees)
+            rs << " " << callee->getName();
+    }
+    else
+    {
+        reply = "error unknown request '" + cmd + "'";
+        return true;
+    }
+    reply = rs.str();
+    return true;
+}
+
+/*!
+ * Serve requests once the SVFIR, Andersen's analysis and the SVFG are built
+ * (or read back with -read-ander/-read-svfg)
+ */
+void DDAPass::serveQueries(const std::string& endpoint)
+{
+    if (endpoint != "-")
+    {
+        serveSocket(endpoint);
+        return;
+    }
+    std::string line, reply;
+    while (std::getline(std::cin, line))
+    {
+        bool open = answerRequest(line, reply);
+        if (!reply.empty())
+            std::cout << reply << std::endl;
+        if (!open)
+            break;
+    }
+}
+
+/*!
+ * Serve clients of a Unix-domain socket one at a time, the solver is not thread-safe
+ */
+void DDAPass::serveSocket(const std::string& path)
+{
+    /// Longest request line a client may send before it is disconnected
+    const size_t MaxRequestSize = 1 << 16;
+
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+        writeWrnMsg("DDA server socket path is too long: " + path);
+        return;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    /// An existing file at the path is never removed, bind fails on it instead
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    bool bound = fd >= 0 && bind(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+    if (!bound || listen(fd, 8) != 0)
+    {
+        writeWrnMsg("DDA server cannot listen on " + path + ": " + std::strerror(errno));
+        if (fd >= 0)
+            close(fd);
+        if (bound)
+            unlink(path.c_str());
+        return;
+    }
+    outs() << "DDA server listening on '" << path << "'\n";
+
+    while (!_serverShutdown)
+    {
+        int conn = accept(fd, nullptr, nullptr);
+        if (conn < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        std::string buf, reply;
+        char chunk[4096];
+        bool open = true;
+        while (open)
+        {
+            ssize_t n = read(conn, chunk, sizeof(chunk));
+            if (n <= 0)
+                break;
+            buf.append(chunk, n);
+            if (buf.find('\n') == std::string::npos && buf.size() > MaxRequestSize)
+            {
+                std::string err = "error request too long\n";
+                send(conn, err.data(), err.size(), MSG_NOSIGNAL);
+                break;
+            }
+            size_t pos;
+            while (open && (pos = buf.find('\n')) != std::string::npos)
+            {
+                std::string line = buf.substr(0, pos);
+                buf.erase(0, pos + 1);
+                open = answerRequest(line, reply);
+                if (reply.empty())
+                    continue;
+                reply += "\n";
+                for (size_t sent = 0; sent < reply.size();)
+                {
+                    ssize_t m = send(conn, reply.data() + sent, reply.size() - sent, MSG_NOSIGNAL);
+                    if (m <= 0)
+                    {
+                        open = false;
+                        break;
+                    }
+                    sent += m;
+                }
+            }
+        }
+        close(conn);
+    }
+    close(fd);
+    unlink(path.c_str());
+}
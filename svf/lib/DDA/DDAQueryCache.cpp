@@ -0,0 +1,518 @@
+//===- DDAQueryCache.cpp -- Persistent cache of resolved DDA queries----------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * DDAQueryCache.cpp
+ *
+ * The text format is
+ *   DDAQueryCache <version>
+ *   funset <hash>                          hash of the names of all functions
+ *   fun <name> <hash> <callhash>           content hash of every function, "@" for globals,
+ *                                          and hash of the call edges into and out of it
+ *   query <var> <#deps> <dep>* <#objs> (<owner> <rank>)* <#pts> <var>*
+ * where a variable <var> is
+ *   <owner> <rank> <offset> <#cxt> (<caller> <rank> <callee>)*
+ * and <offset> is -1 unless the variable is a gep object of the named base object.
+ * The objects of a query are the base objects its loads may read.
+ */
+
+#include "DDA/DDAQueryCache.h"
+#include "Graphs/ICFG.h"
+#include "Util/WorkList.h"
+#include <fstream>
+#include <sstream>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+namespace
+{
+const std::string DDAQueryCacheMagic = "DDAQueryCache";
+const u32_t DDAQueryCacheVersion = 3;
+
+inline u64_t combineHash(u64_t seed, u64_t value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+inline u64_t hashString(const std::string& str)
+{
+    return std::hash<std::string>()(str);
+}
+}
+
+/*!
+ * Rank the variables of every function and compute the content hashes of this run
+ */
+DDAQueryCache::DDAQueryCache(SVFIR* p, PTACallGraph* cg, PointerAnalysis* a) : pag(p), callGraph(cg), ander(a), numOfStaleQueries(0)
+{
+    for (SVFIR::const_iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        /// gep objects are created on demand, they are named after their base object instead
+        if (SVFUtil::isa<GepObjVar>(it->second))
+            continue;
+        std::vector<NodeID>& vars = ownerToVars[it->second->getFunction()];
+        varToRank[it->first] = vars.size();
+        vars.push_back(it->first);
+    }
+
+    for (const SVFFunction* fun : pag->getModule()->getFunctionSet())
+    {
+        nameToFun[fun->getName()] = fun;
+        std::vector<const ICFGNode*>& nodes = funToICFGNodes[fun];
+        for (const SVFBasicBlock* bb : fun->getBasicBlockList())
+        {
+            for (const ICFGNode* node : bb->getICFGNodeList())
+            {
+                icfgNodeToRank[node] = nodes.size();
+                nodes.push_back(node);
+            }
+        }
+    }
+
+    funSetHash = 0;
+    for (const SVFFunction* fun : pag->getModule()->getFunctionSet())
+    {
+        funHashes[fun->getName()] = computeFunctionHash(fun);
+        funCallHashes[fun->getName()] = computeCallEdgeHash(fun);
+        funSetHash += hashString(fun->getName());
+    }
+    funHashes[getOwnerName(nullptr)] = computeFunctionHash(nullptr);
+    funCallHashes[getOwnerName(nullptr)] = 0;
+}
+
+const SVFFunction* DDAQueryCache::getOwner(NodeID id) const
+{
+    const PAGNode* node = pag->getGNode(id);
+    if (const GepObjVar* gep = SVFUtil::dyn_cast<GepObjVar>(node))
+        return pag->getGNode(gep->getBaseNode())->getFunction();
+    return node->getFunction();
+}
+
+u64_t DDAQueryCache::hashVar(NodeID id) const
+{
+    const PAGNode* node = pag->getGNode(id);
+    if (const GepObjVar* gep = SVFUtil::dyn_cast<GepObjVar>(node))
+        return combineHash(hashVar(gep->getBaseNode()), gep->getConstantFieldIdx());
+
+    Map<NodeID, u32_t>::const_iterator it = varToRank.find(id);
+    assert(it != varToRank.end() && "variable not ranked!");
+    u64_t hash = combineHash(hashString(getOwnerName(node->getFunction())), it->second);
+    return combineHash(hash, node->getNodeKind());
+}
+
+u64_t DDAQueryCache::hashStmt(const SVFStmt* stmt) const
+{
+    u64_t hash = combineHash(stmt->getEdgeKind(), hashVar(stmt->getSrcID()));
+    hash = combineHash(hash, hashVar(stmt->getDstID()));
+    if (const GepStmt* gep = SVFUtil::dyn_cast<GepStmt>(stmt))
+    {
+        hash = combineHash(hash, gep->isConstantOffset());
+        if (gep->isConstantOffset())
+            hash = combineHash(hash, gep->accumulateConstantOffset());
+    }
+    return hash;
+}
+
+/*!
+ * A function's hash covers the kind and name of its variables and every statement of its
+ * ICFG nodes, with operands named by owner and rank so that edits elsewhere do not change it
+ */
+u64_t DDAQueryCache::computeFunctionHash(const SVFFunction* fun) const
+{
+    u64_t hash = hashString(getOwnerName(fun));
+    auto vit = ownerToVars.find(fun);
+    if (vit != ownerToVars.end())
+    {
+        for (NodeID id : vit->second)
+        {
+            const PAGNode* node = pag->getGNode(id);
+            hash = combineHash(hash, node->getNodeKind());
+            hash = combineHash(hash, hashString(node->getValueName()));
+        }
+    }
+
+    if (fun == nullptr)
+    {
+        for (const SVFStmt* stmt : pag->getICFG()->getGlobalICFGNode()->getSVFStmts())
+            hash = combineHash(hash, hashStmt(stmt));
+        return hash;
+    }
+
+    auto nit = funToICFGNodes.find(fun);
+    assert(nit != funToICFGNodes.end() && "function not collected!");
+    for (const ICFGNode* node : nit->second)
+    {
+        hash = combineHash(hash, node->getNodeKind());
+        for (const SVFStmt* stmt : node->getSVFStmts())
+            hash = combineHash(hash, hashStmt(stmt));
+    }
+    return hash;
+}
+
+/*!
+ * A new caller or a new (indirect) callee of a function adds value-flows into or out of it
+ * without changing its statements, so the call edges of a function are hashed separately.
+ * Call sites are named by caller, rank and callee and their hashes are summed, so that the
+ * hash does not depend on the order of the edges.
+ */
+u64_t DDAQueryCache::computeCallEdgeHash(const SVFFunction* fun) const
+{
+    const PTACallGraphNode* node = callGraph->getCallGraphNode(fun);
+    u64_t hash = 0;
+    auto addCalls = [&](const PTACallGraphEdge* edge, const PTACallGraphEdge::CallInstSet& calls, bool indirect)
+    {
+        for (const CallICFGNode* cs : calls)
+        {
+            Map<const ICFGNode*, u32_t>::const_iterator it = icfgNodeToRank.find(cs);
+            u64_t h = combineHash(hashString(getOwnerName(edge->getSrcNode()->getFunction())),
+                                  it == icfgNodeToRank.end() ? 0 : it->second + 1);
+            h = combineHash(h, hashString(getOwnerName(edge->getDstNode()->getFunction())));
+            hash += combineHash(h, indirect);
+        }
+    };
+    for (const PTACallGraphEdge* edge : node->getInEdges())
+    {
+        addCalls(edge, edge->getDirectCalls(), false);
+        addCalls(edge, edge->getIndirectCalls(), true);
+    }
+    for (const PTACallGraphEdge* edge : node->getOutEdges())
+    {
+        addCalls(edge, edge->getDirectCalls(), false);
+        addCalls(edge, edge->getIndirectCalls(), true);
+    }
+    return hash;
+}
+
+std::string DDAQueryCache::getStableName(NodeID id) const
+{
+    std::ostringstream ss;
+    const PAGNode* node = pag->getGNode(id);
+    s64_t offset = -1;
+    if (const GepObjVar* gep = SVFUtil::dyn_cast<GepObjVar>(node))
+    {
+        offset = gep->getConstantFieldIdx();
+        id = gep->getBaseNode();
+        node = pag->getGNode(id);
+    }
+    Map<NodeID, u32_t>::const_iterator it = varToRank.find(id);
+    assert(it != varToRank.end() && "variable not ranked!");
+    ss << getOwnerName(node->getFunction()) << " " << it->second << " " << offset;
+    return ss.str();
+}
+
+std::string DDAQueryCache::getStableCallSiteName(CallSiteID csId) const
+{
+    std::ostringstream ss;
+    const CallICFGNode* cs = callGraph->getCallSite(csId);
+    Map<const ICFGNode*, u32_t>::const_iterator it = icfgNodeToRank.find(cs);
+    assert(it != icfgNodeToRank.end() && "call site not ranked!");
+    ss << getOwnerName(cs->getCaller()) << " " << it->second << " " << getOwnerName(callGraph->getCalleeOfCallSite(csId));
+    return ss.str();
+}
+
+std::string DDAQueryCache::getStableName(const CachedVar& var) const
+{
+    std::ostringstream ss;
+    ss << getStableName(var.first) << " " << var.second.size();
+    for (CallSiteID csId : var.second)
+        ss << " " << getStableCallSiteName(csId);
+    return ss.str();
+}
+
+bool DDAQueryCache::getNodeID(const std::string& owner, u32_t rank, s64_t offset, NodeID& id)
+{
+    const SVFFunction* fun = nullptr;
+    if (owner != getOwnerName(nullptr))
+    {
+        Map<std::string, const SVFFunction*>::const_iterator fit = nameToFun.find(owner);
+        if (fit == nameToFun.end())
+            return false;
+        fun = fit->second;
+    }
+    auto vit = ownerToVars.find(fun);
+    if (vit == ownerToVars.end() || rank >= vit->second.size())
+        return false;
+    id = vit->second[rank];
+    if (offset >= 0)
+    {
+        if (!SVFUtil::isa<ObjVar>(pag->getGNode(id)))
+            return false;
+        id = pag->getGepObjVar(id, offset);
+    }
+    return true;
+}
+
+bool DDAQueryCache::getCallSiteID(const std::string& owner, u32_t rank, const std::string& callee, CallSiteID& csId)
+{
+    Map<std::string, const SVFFunction*>::const_iterator cit = nameToFun.find(owner);
+    Map<std::string, const SVFFunction*>::const_iterator fit = nameToFun.find(callee);
+    if (cit == nameToFun.end() || fit == nameToFun.end())
+        return false;
+    const std::vector<const ICFGNode*>& nodes = funToICFGNodes[cit->second];
+    if (rank >= nodes.size())
+        return false;
+    const CallICFGNode* cs = SVFUtil::dyn_cast<CallICFGNode>(nodes[rank]);
+    if (cs == nullptr || !callGraph->hasCallSiteID(cs, fit->second))
+        return false;
+    csId = callGraph->getCallSiteID(cs, fit->second);
+    return true;
+}
+
+bool DDAQueryCache::readCachedVar(std::istringstream& ss, CachedVar& var)
+{
+    std::string owner;
+    u32_t rank;
+    s64_t offset;
+    u32_t cxtSize;
+    if (!(ss >> owner >> rank >> offset >> cxtSize) || !getNodeID(owner, rank, offset, var.first))
+        return false;
+    var.second.clear();
+    for (u32_t i = 0; i < cxtSize; ++i)
+    {
+        std::string callee;
+        CallSiteID csId;
+        if (!(ss >> owner >> rank >> callee) || !getCallSiteID(owner, rank, callee, csId))
+            return false;
+        var.second.push_back(csId);
+    }
+    return true;
+}
+
+void DDAQueryCache::addOwners(const CachedVar& var, OrderedSet<std::string>& deps) const
+{
+    deps.insert(getOwnerName(getOwner(var.first)));
+    for (CallSiteID csId : var.second)
+    {
+        deps.insert(getOwnerName(callGraph->getCallerOfCallSite(csId)));
+        deps.insert(getOwnerName(callGraph->getCalleeOfCallSite(csId)));
+    }
+}
+
+/*!
+ * The traversal of a query may reuse points-to cached by earlier queries of this run, so a
+ * query conservatively depends on every function visited and every object read so far
+ * rather than only its own
+ */
+void DDAQueryCache::addCachedPts(const CachedVar& query, const CachedPts& pts)
+{
+    OrderedSet<std::string> deps;
+    for (const SVFFunction* fun : visitedFuns)
+        deps.insert(getOwnerName(fun));
+    addOwners(query, deps);
+    for (const CachedVar& var : pts)
+        addOwners(var, deps);
+
+    queryToPts[query] = pts;
+    queryToDeps[query] = Dependences(deps.begin(), deps.end());
+    queryToReadObjs[query] = readObjs;
+}
+
+/*!
+ * A changed function which a query never visited may still store to an object the query
+ * loads from, directly or through one of its callees, e.g. a global or a heap object.
+ * Collect the base objects the stores of the changed functions and of everything they
+ * transitively call may write, according to the points-to sets of the whole-program analysis.
+ */
+NodeBS DDAQueryCache::computeModifiedObjects(const Set<std::string>& changedFuns) const
+{
+    NodeBS modObjs;
+    auto addStores = [&](const ICFGNode* node)
+    {
+        for (const SVFStmt* stmt : node->getSVFStmts())
+        {
+            if (const StoreStmt* store = SVFUtil::dyn_cast<StoreStmt>(stmt))
+            {
+                for (NodeID obj : ander->getPts(store->getLHSVarID()))
+                    modObjs.set(pag->getBaseObjVar(obj));
+            }
+        }
+    };
+
+    FIFOWorkList<const SVFFunction*> worklist;
+    FunctionSet visited;
+    for (const std::string& name : changedFuns)
+    {
+        if (name == getOwnerName(nullptr))
+        {
+            addStores(pag->getICFG()->getGlobalICFGNode());
+            continue;
+        }
+        Map<std::string, const SVFFunction*>::const_iterator it = nameToFun.find(name);
+        if (it != nameToFun.end() && visited.insert(it->second).second)
+            worklist.push(it->second);
+    }
+    while (!worklist.empty())
+    {
+        const SVFFunction* fun = worklist.pop();
+        for (const ICFGNode* node : funToICFGNodes.at(fun))
+            addStores(node);
+        for (const PTACallGraphEdge* edge : callGraph->getCallGraphNode(fun)->getOutEdges())
+        {
+            const SVFFunction* callee = edge->getDstNode()->getFunction();
+            if (visited.insert(callee).second)
+                worklist.push(callee);
+        }
+    }
+    return modObjs;
+}
+
+/*!
+ * Keep the queries whose dependences all have the same content and call edge hashes as in this
+ * run and whose objects no changed function may store to. Any change to the set of functions
+ * invalidates every query.
+ */
+bool DDAQueryCache::readFromFile(const std::string& filename)
+{
+    outs() << "Loading DDA query cache from '" << filename << "'...";
+    std::ifstream F(filename.c_str());
+    if (!F.is_open())
+    {
+        outs() << " no cache file, starting cold\n";
+        return false;
+    }
+
+    std::string line;
+    std::string magic;
+    u32_t version = 0;
+    if (!std::getline(F, line) || !(std::istringstream(line) >> magic >> version) ||
+            magic != DDAQueryCacheMagic || version != DDAQueryCacheVersion)
+    {
+        outs() << " not a DDA query cache, starting cold\n";
+        return false;
+    }
+
+    Set<std::string> changedFuns;
+    NodeBS modObjs;
+    bool modObjsComputed = false;
+    bool funSetChanged = true;
+    u32_t numOfQueries = 0;
+    while (std::getline(F, line))
+    {
+        std::istringstream ss(line);
+        std::string tag;
+        ss >> tag;
+        if (tag == "funset")
+        {
+            u64_t hash;
+            funSetChanged = !(ss >> hash) || hash != funSetHash;
+        }
+        else if (tag == "fun")
+        {
+            std::string name;
+            u64_t hash, callHash;
+            bool valid = static_cast<bool>(ss >> name >> hash >> callHash);
+            FunNameToHashMap::const_iterator it = funHashes.find(name);
+            if (!valid || it == funHashes.end() || it->second != hash || funCallHashes.at(name) != callHash)
+                changedFuns.insert(name);
+        }
+        else if (tag == "query")
+        {
+            /// every "fun" line precedes the queries
+            if (!modObjsComputed)
+            {
+                modObjs = computeModifiedObjects(changedFuns);
+                modObjsComputed = true;
+            }
+            CachedVar query;
+            u32_t numOfDeps = 0;
+            bool valid = readCachedVar(ss, query) && (ss >> numOfDeps);
+            Dependences deps;
+            for (u32_t i = 0; valid && i < numOfDeps; ++i)
+            {
+                std::string dep;
+                valid = (ss >> dep) && changedFuns.find(dep) == changedFuns.end();
+                deps.push_back(dep);
+            }
+            u32_t numOfObjs = 0;
+            valid = valid && (ss >> numOfObjs);
+            NodeBS objs;
+            for (u32_t i = 0; valid && i < numOfObjs; ++i)
+            {
+                std::string owner;
+                u32_t rank;
+                NodeID obj;
+                valid = (ss >> owner >> rank) && getNodeID(owner, rank, -1, obj) &&
+                        SVFUtil::isa<ObjVar>(pag->getGNode(obj)) && !modObjs.test(obj);
+                objs.set(obj);
+            }
+            u32_t numOfPts = 0;
+            valid = valid && (ss >> numOfPts);
+            CachedPts pts;
+            for (u32_t i = 0; valid && i < numOfPts; ++i)
+            {
+                CachedVar var;
+                valid = readCachedVar(ss, var);
+                pts.push_back(var);
+            }
+            if (!valid || funSetChanged)
+            {
+                numOfStaleQueries++;
+                continue;
+            }
+            queryToPts[query] = pts;
+            queryToDeps[query] = deps;
+            queryToReadObjs[query] = objs;
+            numOfQueries++;
+        }
+    }
+    outs() << " " << numOfQueries << " queries reused, " << numOfStaleQueries << " invalidated\n";
+    return true;
+}
+
+void DDAQueryCache::writeToFile(const std::string& filename) const
+{
+    outs() << "Writing DDA query cache to '" << filename << "'...";
+    std::ofstream F(filename.c_str());
+    if (!F.is_open())
+    {
+        outs() << " error opening file for writing!\n";
+        return;
+    }
+
+    F << DDAQueryCacheMagic << " " << DDAQueryCacheVersion << "\n";
+    F << "funset " << funSetHash << "\n";
+    for (const auto& it : funHashes)
+        F << "fun " << it.first << " " << it.second << " " << funCallHashes.at(it.first) << "\n";
+
+    for (const auto& it : queryToPts)
+    {
+        const Dependences& deps = queryToDeps.at(it.first);
+        F << "query " << getStableName(it.first) << " " << deps.size();
+        for (const std::string& dep : deps)
+            F << " " << dep;
+        const NodeBS& objs = queryToReadObjs.at(it.first);
+        F << " " << objs.count();
+        for (NodeID obj : objs)
+        {
+            Map<NodeID, u32_t>::const_iterator rit = varToRank.find(obj);
+            assert(rit != varToRank.end() && "object not ranked!");
+            F << " " << getOwnerName(pag->getGNode(obj)->getFunction()) << " " << rit->second;
+        }
+        F << " " << it.second.size();
+        for (const CachedVar& var : it.second)
+            F << " " << getStableName(var);
+        F << "\n";
+    }
+    F.close();
+    outs() << " done\n";
+}
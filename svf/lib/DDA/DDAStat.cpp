@@ -34,6 +34,7 @@
 #include "MemoryModel/PointsTo.h"
 
 #include <iomanip>
+#include <fstream>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -52,6 +53,7 @@ void DDAStat::initDefault()
 {
     _TotalNumOfQuery = 0;
     _TotalNumOfOutOfBudgetQuery = 0;
+    _MergedNumOfOutOfBudgetQuery = 0;
     _TotalNumOfDPM = 0;
     _TotalNumOfStrongUpdates = 0;
     _TotalNumOfMustAliases = 0;
@@ -68,6 +70,7 @@ void DDAStat::initDefault()
     _AvgNumOfDPMAtSVFGNode = 0;
     _MaxNumOfDPMAtSVFGNode = 0;
     _TotalTimeOfQueries = 0;
+    _TotalTimeOfBKCondition = 0;
     _AnaTimePerQuery = 0;
     _AnaTimeCyclePerQuery = 0;
 
@@ -76,6 +79,9 @@ void DDAStat::initDefault()
     _NumOfStrongUpdates = 0;
     _NumOfMustAliases = 0;
     _NumOfInfeasiblePath = 0;
+    _NumOfQueryCacheHit = 0;
+    _NumOfSummaries = 0;
+    _NumOfSummaryUses = 0;
 
     _NumOfStep = 0;
     _NumOfStepInCycle = 0;
@@ -212,6 +218,68 @@ void DDAStat::getNumOfOOBQuery()
         _TotalNumOfOutOfBudgetQuery = flowDDA->outOfBudgetDpms.size();
     else if (contextDDA)
         _TotalNumOfOutOfBudgetQuery = contextDDA->outOfBudgetDpms.size();
+    _TotalNumOfOutOfBudgetQuery += _MergedNumOfOutOfBudgetQuery;
+}
+
+void DDAStat::mergeStat(const DDAStat& other)
+{
+    _TotalNumOfQuery += other._TotalNumOfQuery;
+    _TotalNumOfDPM += other._TotalNumOfDPM;
+    _TotalNumOfStrongUpdates += other._TotalNumOfStrongUpdates;
+    _TotalNumOfMustAliases += other._TotalNumOfMustAliases;
+    _TotalNumOfInfeasiblePath += other._TotalNumOfInfeasiblePath;
+    _NumOfQueryCacheHit += other._NumOfQueryCacheHit;
+    _NumOfSummaries += other._NumOfSummaries;
+    _NumOfSummaryUses += other._NumOfSummaryUses;
+    _TotalNumOfStep += other._TotalNumOfStep;
+    _TotalNumOfStepInCycle += other._TotalNumOfStepInCycle;
+
+    _MaxCPtsSize = std::max(_MaxCPtsSize, other._MaxCPtsSize);
+    _MaxPtsSize = std::max(_MaxPtsSize, other._MaxPtsSize);
+    _TotalCPtsSize += other._TotalCPtsSize;
+    _TotalPtsSize += other._TotalPtsSize;
+    _NumOfNullPtr += other._NumOfNullPtr;
+    _NumOfConstantPtr += other._NumOfConstantPtr;
+    _NumOfBlackholePtr += other._NumOfBlackholePtr;
+    _AvgNumOfDPMAtSVFGNode += other._AvgNumOfDPMAtSVFGNode;
+    _MaxNumOfDPMAtSVFGNode = std::max(_MaxNumOfDPMAtSVFGNode, other._MaxNumOfDPMAtSVFGNode);
+
+    _QueryProfiles.insert(_QueryProfiles.end(), other._QueryProfiles.begin(), other._QueryProfiles.end());
+    _TotalTimeOfQueries += other._TotalTimeOfQueries;
+    _TotalTimeOfBKCondition += other._TotalTimeOfBKCondition;
+    _StrongUpdateStores |= other._StrongUpdateStores;
+
+    if (other.flowDDA)
+        _MergedNumOfOutOfBudgetQuery += other.flowDDA->outOfBudgetDpms.size();
+    else if (other.contextDDA)
+        _MergedNumOfOutOfBudgetQuery += other.contextDDA->outOfBudgetDpms.size();
+
+    _QueryLatencies.insert(_QueryLatencies.end(), other._QueryLatencies.begin(), other._QueryLatencies.end());
+}
+
+/*!
+ * Nearest-rank percentile of query latencies (sorted ascendingly)
+ */
+void DDAStat::writeQueryProfile(const std::string& filename) const
+{
+    std::ofstream F(filename.c_str());
+    if (!F.is_open())
+    {
+        SVFUtil::outs() << "Writing DDA query profile to '" << filename << "'... error opening file for writing!\n";
+        return;
+    }
+    F << "ptr,cost,schedule,flowPts,pts,time\n";
+    for (const QueryProfile& profile : _QueryProfiles)
+        F << profile.ptr << "," << profile.cost << "," << profile.schedule << "," << profile.flowPtsSize << ","
+          << profile.ptsSize << "," << profile.time / TIMEINTERVAL << "\n";
+}
+
+double DDAStat::getQueryLatencyPercentile(const std::vector<double>& sorted, u32_t percentile) const
+{
+    if (sorted.empty())
+        return 0;
+    size_t rank = (sorted.size() * percentile + 99) / 100;
+    return sorted[rank == 0 ? 0 : rank - 1];
 }
 
 void DDAStat::performStat()
@@ -241,6 +309,13 @@ void DDAStat::performStat()
     timeStatMap["AvgTimePerQuery"] =  (_TotalTimeOfQueries/TIMEINTERVAL)/_TotalNumOfQuery;
     timeStatMap["TotalBKCondTime"] =  (_TotalTimeOfBKCondition/TIMEINTERVAL);
 
+    std::vector<double> latencies(_QueryLatencies);
+    std::sort(latencies.begin(), latencies.end());
+    timeStatMap["QueryLatencyP50"] = getQueryLatencyPercentile(latencies, 50)/TIMEINTERVAL;
+    timeStatMap["QueryLatencyP90"] = getQueryLatencyPercentile(latencies, 90)/TIMEINTERVAL;
+    timeStatMap["QueryLatencyP99"] = getQueryLatencyPercentile(latencies, 99)/TIMEINTERVAL;
+    timeStatMap["QueryLatencyMax"] = getQueryLatencyPercentile(latencies, 100)/TIMEINTERVAL;
+
     PTNumStatMap["NumOfQuery"] = _TotalNumOfQuery;
     PTNumStatMap["NumOfOOBQuery"] = _TotalNumOfOutOfBudgetQuery;
     PTNumStatMap["NumOfDPM"] = _TotalNumOfDPM;
@@ -262,6 +337,17 @@ void DDAStat::performStat()
     PTNumStatMap["PointsToBlkPtr"] = _NumOfBlackholePtr;
     PTNumStatMap["NumOfMustAA"] = _TotalNumOfMustAliases;
     PTNumStatMap["NumOfInfePath"] = _TotalNumOfInfeasiblePath;
+    PTNumStatMap["NumOfCacheHitQuery"] = _NumOfQueryCacheHit;
+    PTNumStatMap["NumOfSummary"] = _NumOfSummaries;
+    if (!_QueryProfiles.empty())
+    {
+        u32_t refined = 0;
+        for (const QueryProfile& profile : _QueryProfiles)
+            refined += profile.schedule == "refined";
+        PTNumStatMap["NumOfRefinedQuery"] = refined;
+        PTNumStatMap["NumOfFlowOnlyQuery"] = _QueryProfiles.size() - refined;
+    }
+    PTNumStatMap["NumOfSummaryUse"] = _NumOfSummaryUses;
     PTNumStatMap["NumOfStore"] = SVFIR::getPAG()->getPTASVFStmtSet(SVFStmt::Store).size();
     timeStatMap["MemoryUsageVmrss"] = _vmrssUsageAfter - _vmrssUsageBefore;
     timeStatMap["MemoryUsageVmsize"] = _vmsizeUsageAfter - _vmsizeUsageBefore;
@@ -42,8 +42,11 @@ using namespace SVFUtil;
  */
 void FlowDDA::computeDDAPts(NodeID id)
 {
+    if (queryCache && answerFromQueryCache(id))
+        return;
+
     resetQuery();
-    LocDPItem::setMaxBudget(Options::FlowBudget());
+    LocDPItem::setMaxBudget(queryBudget ? queryBudget : Options::FlowBudget());
 
     PAGNode* node = getPAG()->getGNode(id);
     LocDPItem dpm = getDPIm(node->getId(),getDefSVFGNode(node));
@@ -59,6 +62,9 @@ void FlowDDA::computeDDAPts(NodeID id)
     else
         handleOutOfBudgetDpm(dpm);
 
+    if (queryCache)
+        addToQueryCache(id);
+
     if(this->printStat())
         DOSTAT(stat->performStatPerQuery(node->getId()));
 
@@ -66,6 +72,50 @@ void FlowDDA::computeDDAPts(NodeID id)
 }
 
 
+/*!
+ * Answer a query with the points-to cached by a previous run, return false if it has to be computed
+ */
+bool FlowDDA::answerFromQueryCache(NodeID id)
+{
+    const DDAQueryCache::CachedPts* cached = queryCache->getCachedPts(std::make_pair(id, CallStrCxt()));
+    if (cached == nullptr)
+        return false;
+
+    PointsTo pts;
+    for (const DDAQueryCache::CachedVar& obj : *cached)
+        pts.set(obj.first);
+    unionPts(id, pts);
+    ddaStat->_NumOfQueryCacheHit++;
+    return true;
+}
+
+/*!
+ * Record the answer of the current query, out-of-budget answers depend on the budget and are not kept
+ */
+void FlowDDA::addToQueryCache(NodeID id)
+{
+    addQueryCacheDependences();
+    if (isOutOfBudgetQuery())
+        return;
+
+    DDAQueryCache::CachedPts pts;
+    for (NodeID obj : getPts(id))
+        pts.push_back(std::make_pair(obj, CallStrCxt()));
+    queryCache->addCachedPts(std::make_pair(id, CallStrCxt()), pts);
+}
+
+/*!
+ * Take over points-to of the queries answered by worker, the indirect calls it
+ * resolved and its statistics
+ */
+void FlowDDA::mergeQueryResults(FlowDDA* worker, const std::vector<NodeID>& queries)
+{
+    for (NodeID id : queries)
+        unionPts(id, worker->getPts(id));
+    mergeIndirectCalls(worker->getIndCallMap());
+    ddaStat->mergeStat(*worker->ddaStat);
+}
+
 /*!
  * Handle out-of-budget dpm
  */
@@ -232,7 +232,9 @@ void SVFG::buildSVFG()
     stat->startClk();
     if (!Options::ReadSVFG().empty())
     {
+        stat->readSVFGStart();
         readFile(Options::ReadSVFG());
+        stat->readSVFGEnd();
     }
     else
     {
@@ -245,7 +247,11 @@ void SVFG::buildSVFG()
         connectIndirectSVFGEdges();
         stat->indVFEdgeEnd();
         if (!Options::WriteSVFG().empty())
+        {
+            stat->writeSVFGStart();
             writeToFile(Options::WriteSVFG());
+            stat->writeSVFGEnd();
+        }
     }
 }
 
@@ -462,11 +468,6 @@ void SVFG::connectFromGlobalToProgEntry()
  */
 SVFGEdge* SVFG::addIntraIndirectVFEdge(NodeID srcId, NodeID dstId, const NodeBS& cpts)
 {
-    // for (NodeBS::iterator it = cpts.begin(), eit = cpts.end(); it != eit; ++it)
-    // {
-    //     SVFUtil::outs() << *it << " ";
-    // }
-    SVFUtil::outs() << "\n";
     SVFGNode* srcNode = getSVFGNode(srcId);
     SVFGNode* dstNode = getSVFGNode(dstId);
     checkIntraEdgeParents(srcNode, dstNode);
@@ -35,6 +35,8 @@
 #include "Util/Options.h"
 #include "Graphs/SVFGOPT.h"
 #include "Graphs/SVFGStat.h"
+#include <atomic>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -56,9 +58,16 @@ void SVFGOPT::buildSVFG()
     keepActualOutFormalIn = Options::KeepAOFI();
 
     stat->sfvgOptStart();
+    u32_t numOfNodes = IDToNodeMap.size();
+    stat->interOptStart();
     handleInterValueFlow();
+    stat->interOptEnd();
+    u32_t numOfNodesAfterInter = IDToNodeMap.size();
 
+    stat->intraOptStart();
     handleIntraValueFlow();
+    stat->intraOptEnd();
+    stat->setOptRemovedNodes(numOfNodes - numOfNodesAfterInter, numOfNodesAfterInter - IDToNodeMap.size());
     stat->sfvgOptEnd();
 
 }
@@ -101,6 +110,7 @@ void SVFGOPT::handleInterValueFlow()
     }
 
     SVFGNodeSet nodesToBeDeleted;
+    std::vector<SVFGNode*> aInFOuts;
     for (SVFGNodeSet::const_iterator it = candidates.begin(), eit = candidates.end();
             it!=eit; ++it)
     {
@@ -121,7 +131,7 @@ void SVFGOPT::handleInterValueFlow()
         }
         else if (SVFUtil::isa<ActualINSVFGNode, FormalOUTSVFGNode>(node))
         {
-            retargetEdgesOfAInFOut(node);
+            aInFOuts.push_back(node);
             nodesToBeDeleted.insert(node);
         }
         else if (SVFUtil::isa<ActualOUTSVFGNode, FormalINSVFGNode>(node))
@@ -131,6 +141,8 @@ void SVFGOPT::handleInterValueFlow()
         }
     }
 
+    retargetEdgesOfAInFOut(aInFOuts);
+
     for (SVFGNodeSet::iterator it = nodesToBeDeleted.begin(), eit = nodesToBeDeleted.end(); it != eit; ++it)
     {
         SVFGNode* node = *it;
@@ -200,30 +212,87 @@ void SVFGOPT::replaceFParamARetWithPHI(PHISVFGNode* phi, SVFGNode* svfgNode)
 /*!
  * Record def sites of actual-in/formal-out and connect from those def-sites
  * to formal-in/actual-out directly if they exist.
+ *
+ * The def of an actual-in/formal-out is never another actual-in/formal-out and their
+ * successors are formal-ins/actual-outs, so retargeting one node neither reads nor
+ * writes the edges of another. New edges are therefore collected per function in
+ * parallel and added to the graph afterwards in function order.
  */
-void SVFGOPT::retargetEdgesOfAInFOut(SVFGNode* node)
+void SVFGOPT::retargetEdgesOfAInFOut(const std::vector<SVFGNode*>& nodes)
 {
-    assert(node->getInEdges().size() == 1 && "actual-in/formal-out can only have one incoming edge as its def size");
+    Map<const SVFFunction*, u32_t> funToIdx;
+    std::vector<std::vector<SVFGNode*>> funNodes;
+    for (SVFGNode* node : nodes)
+    {
+        auto it = funToIdx.emplace(node->getFun(), funNodes.size());
+        if (it.second)
+            funNodes.emplace_back();
+        funNodes[it.first->second].push_back(node);
+    }
+
+    std::vector<std::vector<NodeID>> funDefs(funNodes.size());
+    std::vector<RetargetEdgeBuffer> funEdges(funNodes.size());
+    auto collect = [&](size_t i)
+    {
+        for (const SVFGNode* node : funNodes[i])
+            funDefs[i].push_back(collectRetargetEdgesOfAInFOut(node, funEdges[i]));
+    };
 
-    SVFGNode* def = nullptr;
-    NodeBS inPointsTo;
+    const u32_t numThreads = std::max<u32_t>(1, std::min<u32_t>(Options::SVFGOptThreads(), funNodes.size()));
+    if (numThreads == 1)
+    {
+        for (size_t i = 0; i < funNodes.size(); ++i)
+            collect(i);
+    }
+    else
+    {
+        std::atomic<size_t> nextFun(0);
+        std::vector<std::thread> workers;
+        for (u32_t t = 0; t < numThreads; ++t)
+        {
+            workers.push_back(std::thread([&]()
+            {
+                for (size_t i = nextFun++; i < funNodes.size(); i = nextFun++)
+                    collect(i);
+            }));
+        }
+        for (std::thread &worker : workers) worker.join();
+    }
 
-    SVFGNode::const_iterator it = node->InEdgeBegin();
-    SVFGNode::const_iterator eit = node->InEdgeEnd();
-    for (; it != eit; ++it)
+    for (size_t i = 0; i < funNodes.size(); ++i)
     {
-        const IndirectSVFGEdge* inEdge = SVFUtil::cast<IndirectSVFGEdge>(*it);
-        inPointsTo = inEdge->getPointsTo();
-
-        def = inEdge->getSrcNode();
-        if (SVFUtil::isa<ActualINSVFGNode>(node))
-            setActualINDef(node->getId(), def->getId());
-        else if (SVFUtil::isa<FormalOUTSVFGNode>(node))
-            setFormalOUTDef(node->getId(), def->getId());
+        for (size_t n = 0; n < funNodes[i].size(); ++n)
+        {
+            const SVFGNode* node = funNodes[i][n];
+            if (SVFUtil::isa<ActualINSVFGNode>(node))
+                setActualINDef(node->getId(), funDefs[i][n]);
+            else
+                setFormalOUTDef(node->getId(), funDefs[i][n]);
+            removeAllEdges(node);
+        }
+        for (const RetargetEdge& edge : funEdges[i])
+        {
+            if (edge.kind == SVFGEdge::CallIndVF)
+                addCallIndirectSVFGEdge(edge.src, edge.dst, edge.csId, edge.pts);
+            else
+                addRetIndirectSVFGEdge(edge.src, edge.dst, edge.csId, edge.pts);
+        }
     }
+}
+
+/*!
+ * Return the def site of actual-in/formal-out and append the edges from it to
+ * the node's successors. The graph is not modified.
+ */
+NodeID SVFGOPT::collectRetargetEdgesOfAInFOut(const SVFGNode* node, RetargetEdgeBuffer& edges) const
+{
+    assert(node->getInEdges().size() == 1 && "actual-in/formal-out can only have one incoming edge as its def size");
 
-    it = node->OutEdgeBegin(), eit = node->OutEdgeEnd();
-    for (; it != eit; ++it)
+    const IndirectSVFGEdge* inEdge = SVFUtil::cast<IndirectSVFGEdge>(*node->InEdgeBegin());
+    const NodeBS& inPointsTo = inEdge->getPointsTo();
+    NodeID def = inEdge->getSrcID();
+
+    for (SVFGNode::const_iterator it = node->OutEdgeBegin(), eit = node->OutEdgeEnd(); it != eit; ++it)
     {
         const IndirectSVFGEdge* outEdge = SVFUtil::cast<IndirectSVFGEdge>(*it);
         NodeBS intersection = inPointsTo;
@@ -232,16 +301,14 @@ void SVFGOPT::retargetEdgesOfAInFOut(SVFGNode* node)
         if (intersection.empty())
             continue;
 
-        SVFGNode* dstNode = outEdge->getDstNode();
         if (const CallIndSVFGEdge* callEdge = SVFUtil::dyn_cast<CallIndSVFGEdge>(outEdge))
-            addCallIndirectSVFGEdge(def->getId(), dstNode->getId(), callEdge->getCallSiteId(), intersection);
+            edges.push_back({SVFGEdge::CallIndVF, def, outEdge->getDstID(), callEdge->getCallSiteId(), intersection});
         else if (const RetIndSVFGEdge* retEdge = SVFUtil::dyn_cast<RetIndSVFGEdge>(outEdge))
-            addRetIndirectSVFGEdge(def->getId(), dstNode->getId(), retEdge->getCallSiteId(), intersection);
+            edges.push_back({SVFGEdge::RetIndVF, def, outEdge->getDstID(), retEdge->getCallSiteId(), intersection});
         else
             assert(false && "expecting an inter-procedural SVFG edge");
     }
-
-    removeAllEdges(node);
+    return def;
 }
 
 /*!
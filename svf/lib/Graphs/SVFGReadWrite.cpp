@@ -33,12 +33,555 @@
 #include "Graphs/SVFGStat.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "Util/Options.h"
 
 using namespace SVF;
 using namespace SVFUtil;
 using namespace std;
 
+// Format of the binary snapshot (integers are stored in host byte order)
+// header   : magic "SVFGBIN\0" | u32 format version | u32 number of sections
+// sections : number of sections x { u32 kind | u32 reserved | u64 offset | u64 size }
+// PTS      : u32 #sets,   { u32 #objs, u32 obj... }                       -- interned points-to sets
+// MRVERS   : u32 #vers,   { u32 region pts | u32 ssa version | u32 def type }
+// NODES    : u32 #nodes,  { u32 kind | u32 id | u32 icfg node | u32 mrver [| u32 #ops, { u32 pos | u32 mrver }] }
+// EDGES    : u32 #edges,  { u32 edge kind | u32 src | u32 dst | u32 pts | u32 callsite }
+namespace
+{
+
+const char SVFGBinMagic[8] = {'S', 'V', 'F', 'G', 'B', 'I', 'N', '\0'};
+const u32_t SVFGBinVersion = 1;
+
+enum SVFGBinSection
+{
+    PtsSection,
+    MRVerSection,
+    NodeSection,
+    EdgeSection,
+    NumOfSections
+};
+
+enum SVFGBinNodeK
+{
+    BinFormalIN,
+    BinFormalOUT,
+    BinActualIN,
+    BinActualOUT,
+    BinMSSAPHI
+};
+
+/// Append-only buffer for one section
+class SVFGBinBuffer
+{
+public:
+    inline void put(u32_t v)
+    {
+        buf.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+    inline void put(u64_t v)
+    {
+        buf.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+    inline void put(const void* data, size_t size)
+    {
+        buf.append(static_cast<const char*>(data), size);
+    }
+    inline const std::string& data() const
+    {
+        return buf;
+    }
+private:
+    std::string buf;
+};
+
+/// Cursor over one mmap-ed section, reading past its end yields zeros and marks it truncated
+class SVFGBinCursor
+{
+public:
+    SVFGBinCursor(const char* b, const char* e): cur(b), end(e), truncated(false) {}
+    inline u32_t u32()
+    {
+        u32_t v = 0;
+        read(&v, sizeof(v));
+        return v;
+    }
+    inline u64_t u64()
+    {
+        u64_t v = 0;
+        read(&v, sizeof(v));
+        return v;
+    }
+    /// Read a count of records of at least recordSize bytes each, zero if they cannot fit
+    inline u32_t count(size_t recordSize)
+    {
+        u32_t n = u32();
+        if ((size_t)(end - cur) / recordSize < n)
+        {
+            truncated = true;
+            return 0;
+        }
+        return n;
+    }
+    inline bool isTruncated() const
+    {
+        return truncated;
+    }
+    inline bool atEnd() const
+    {
+        return cur == end;
+    }
+private:
+    inline void read(void* v, size_t size)
+    {
+        if ((size_t)(end - cur) < size)
+        {
+            truncated = true;
+            cur = end;
+            return;
+        }
+        std::memcpy(v, cur, size);
+        cur += size;
+    }
+    const char* cur;
+    const char* end;
+    bool truncated;
+};
+
+/// Decoded records of the binary snapshot, validated before the SVFG is changed
+struct SVFGBinMRVer
+{
+    u32_t pts;
+    MRVERSION ssaVer;
+    MSSADEF::DEFTYPE defType;
+};
+
+struct SVFGBinNode
+{
+    SVFGBinNodeK kind;
+    NodeID id;
+    NodeID icfgNode;
+    u32_t mrver;
+    std::vector<std::pair<u32_t, u32_t>> opVers;	///< (pos, mrver) of an MSSAPHI
+};
+
+struct SVFGBinEdge
+{
+    SVFGEdge::SVFGEdgeK kind;
+    NodeID src;
+    NodeID dst;
+    u32_t pts;
+    CallSiteID csId;
+};
+
+/// Report a malformed snapshot and stop, a partially loaded SVFG would silently miss value-flows
+[[noreturn]] void reportBadSVFGBinary(const std::string& filename, const std::string& reason)
+{
+    SVFUtil::errs() << "\nError: malformed SVFG binary file '" << filename << "': " << reason << "\n";
+    abort();
+}
+
+/// Intern points-to sets so that region and edge labels are stored once
+class SVFGBinPtsTable
+{
+public:
+    inline u32_t intern(const NodeBS& pts)
+    {
+        auto it = ptsToId.emplace(pts, ptsToId.size());
+        if (it.second)
+            ptsList.push_back(&it.first->first);
+        return it.first->second;
+    }
+    void write(SVFGBinBuffer& out) const
+    {
+        out.put((u32_t) ptsList.size());
+        for (const NodeBS* pts : ptsList)
+        {
+            out.put((u32_t) pts->count());
+            for (NodeID o : *pts)
+                out.put((u32_t) o);
+        }
+    }
+private:
+    Map<NodeBS, u32_t> ptsToId;
+    std::vector<const NodeBS*> ptsList;
+};
+
+}
+
+bool SVFG::isBinaryFile(const string& filename)
+{
+    ifstream F(filename.c_str(), std::ios_base::binary);
+    char magic[sizeof(SVFGBinMagic)];
+    if (!F.read(magic, sizeof(magic)))
+        return false;
+    return std::memcmp(magic, SVFGBinMagic, sizeof(magic)) == 0;
+}
+
+/*!
+ * Write the address-taken part of the SVFG (MSSA nodes and indirect edges) as a binary snapshot.
+ * Nodes and edges are emitted in a single pass over the graph; points-to sets of memory regions
+ * and of edge labels are interned into one table and referenced by index.
+ */
+void SVFG::writeBinaryFile(const string& filename)
+{
+    outs() << "Writing SVFG analysis to '" << filename << "'...";
+    std::fstream f(filename.c_str(), std::ios_base::out | std::ios_base::binary);
+    if (!f.good())
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+
+    SVFGBinPtsTable ptsTable;
+    Map<const MRVer*, u32_t> mrVerToId;
+    SVFGBinBuffer mrvers, nodes, edges;
+    u32_t numOfNodes = 0, numOfEdges = 0;
+
+    auto internMRVer = [&](const MRVer* ver) -> u32_t
+    {
+        auto it = mrVerToId.emplace(ver, mrVerToId.size());
+        if (it.second)
+        {
+            mrvers.put(ptsTable.intern(ver->getMR()->getPointsTo()));
+            mrvers.put((u32_t) ver->getSSAVersion());
+            mrvers.put((u32_t) ver->getDef()->getType());
+        }
+        return it.first->second;
+    };
+    auto putNode = [&](SVFGBinNodeK kind, NodeID id, NodeID icfgId, const MRVer* ver)
+    {
+        nodes.put((u32_t) kind);
+        nodes.put((u32_t) id);
+        nodes.put((u32_t) icfgId);
+        nodes.put(internMRVer(ver));
+        ++numOfNodes;
+    };
+
+    for (iterator it = begin(), eit = end(); it != eit; ++it)
+    {
+        NodeID nodeId = it->first;
+        const SVFGNode* node = it->second;
+        if (const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+            putNode(BinFormalIN, nodeId, formalIn->getFunEntryNode()->getId(), formalIn->getMRVer());
+        else if (const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+            putNode(BinFormalOUT, nodeId, formalOut->getFunExitNode()->getId(), formalOut->getMRVer());
+        else if (const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+            putNode(BinActualIN, nodeId, actualIn->getCallSite()->getId(), actualIn->getMRVer());
+        else if (const ActualOUTSVFGNode* actualOut = SVFUtil::dyn_cast<ActualOUTSVFGNode>(node))
+            putNode(BinActualOUT, nodeId, actualOut->getCallSite()->getId(), actualOut->getMRVer());
+        else if (const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+        {
+            putNode(BinMSSAPHI, nodeId, phiNode->getICFGNode()->getId(), phiNode->getResVer());
+            nodes.put((u32_t) phiNode->getOpVerNum());
+            for (MemSSA::PHI::OPVers::const_iterator vit = phiNode->opVerBegin(), veit = phiNode->opVerEnd();
+                    vit != veit; ++vit)
+            {
+                nodes.put((u32_t) vit->first);
+                nodes.put(internMRVer(vit->second));
+            }
+        }
+
+        for (const SVFGEdge* edge : node->getOutEdges())
+        {
+            const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge);
+            if (indEdge == nullptr)
+                continue;
+            CallSiteID csId = 0;
+            if (const CallIndSVFGEdge* callEdge = SVFUtil::dyn_cast<CallIndSVFGEdge>(indEdge))
+                csId = callEdge->getCallSiteId();
+            else if (const RetIndSVFGEdge* retEdge = SVFUtil::dyn_cast<RetIndSVFGEdge>(indEdge))
+                csId = retEdge->getCallSiteId();
+            edges.put((u32_t) indEdge->getEdgeKind());
+            edges.put((u32_t) indEdge->getSrcID());
+            edges.put((u32_t) indEdge->getDstID());
+            edges.put(ptsTable.intern(indEdge->getPointsTo()));
+            edges.put((u32_t) csId);
+            ++numOfEdges;
+        }
+    }
+
+    SVFGBinBuffer sections[NumOfSections];
+    ptsTable.write(sections[PtsSection]);
+    sections[MRVerSection].put((u32_t) mrVerToId.size());
+    sections[MRVerSection].put(mrvers.data().data(), mrvers.data().size());
+    sections[NodeSection].put(numOfNodes);
+    sections[NodeSection].put(nodes.data().data(), nodes.data().size());
+    sections[EdgeSection].put(numOfEdges);
+    sections[EdgeSection].put(edges.data().data(), edges.data().size());
+
+    SVFGBinBuffer header;
+    header.put(SVFGBinMagic, sizeof(SVFGBinMagic));
+    header.put(SVFGBinVersion);
+    header.put((u32_t) NumOfSections);
+    u64_t offset = sizeof(SVFGBinMagic) + 2 * sizeof(u32_t) + NumOfSections * (2 * sizeof(u32_t) + 2 * sizeof(u64_t));
+    for (u32_t i = 0; i < NumOfSections; ++i)
+    {
+        header.put(i);
+        header.put((u32_t) 0);
+        header.put(offset);
+        header.put((u64_t) sections[i].data().size());
+        offset += sections[i].data().size();
+    }
+    f.write(header.data().data(), header.data().size());
+    for (u32_t i = 0; i < NumOfSections; ++i)
+        f.write(sections[i].data().data(), sections[i].data().size());
+
+    f.close();
+    if (f.good())
+    {
+        outs() << "\n";
+        return;
+    }
+    outs() << "  error writing file!\n";
+}
+
+/*!
+ * Load a binary snapshot written by writeBinaryFile.
+ * The file is mapped read-only and every section is decoded in place; edges are restored
+ * with their stored labels and call site IDs rather than being re-derived from memory SSA.
+ * All sections are decoded and validated before the graph is changed; a malformed or truncated
+ * file is reported as an error.
+ */
+void SVFG::readBinaryFile(const string& filename)
+{
+    outs() << "Loading SVFG analysis results from '" << filename << "'...";
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        outs() << " error opening file for reading!\n";
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        outs() << " error opening file for reading!\n";
+        return;
+    }
+    size_t fileSize = st.st_size;
+    void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        outs() << " error mapping file for reading!\n";
+        return;
+    }
+    const char* base = static_cast<const char*>(mapped);
+
+    /// Validate the header and section table before touching the graph
+    const size_t headerSize = sizeof(SVFGBinMagic) + 2 * sizeof(u32_t);
+    const size_t entrySize = 2 * sizeof(u32_t) + 2 * sizeof(u64_t);
+    SVFGBinCursor header(base + sizeof(SVFGBinMagic), base + fileSize);
+    if (fileSize < headerSize || std::memcmp(base, SVFGBinMagic, sizeof(SVFGBinMagic)) != 0)
+        reportBadSVFGBinary(filename, "bad magic");
+    u32_t version = header.u32();
+    u32_t numOfSections = header.u32();
+    if (version != SVFGBinVersion)
+        reportBadSVFGBinary(filename, "unsupported version " + std::to_string(version));
+    if (numOfSections != NumOfSections || fileSize < headerSize + numOfSections * entrySize)
+        reportBadSVFGBinary(filename, "truncated section table");
+    const char* sectionBegin[NumOfSections] = {};
+    const char* sectionEnd[NumOfSections] = {};
+    for (u32_t i = 0; i < numOfSections; ++i)
+    {
+        u32_t kind = header.u32();
+        header.u32();
+        u64_t offset = header.u64();
+        u64_t size = header.u64();
+        if (kind >= NumOfSections || offset > fileSize || size > fileSize - offset)
+            reportBadSVFGBinary(filename, "corrupted section table");
+        if (sectionBegin[kind] != nullptr)
+            reportBadSVFGBinary(filename, "duplicated section " + std::to_string(kind));
+        sectionBegin[kind] = base + offset;
+        sectionEnd[kind] = base + offset + size;
+    }
+    for (u32_t kind = 0; kind < NumOfSections; ++kind)
+    {
+        if (sectionBegin[kind] == nullptr)
+            reportBadSVFGBinary(filename, "missing section " + std::to_string(kind));
+    }
+
+    /// Decode and validate every section first
+    SVFGBinCursor ptsCursor(sectionBegin[PtsSection], sectionEnd[PtsSection]);
+    std::vector<NodeBS> ptsList(ptsCursor.count(sizeof(u32_t)));
+    for (NodeBS& pts : ptsList)
+    {
+        for (u32_t n = ptsCursor.count(sizeof(u32_t)); n > 0; --n)
+            pts.set(ptsCursor.u32());
+    }
+    if (ptsCursor.isTruncated() || !ptsCursor.atEnd())
+        reportBadSVFGBinary(filename, "truncated points-to section");
+
+    SVFGBinCursor verCursor(sectionBegin[MRVerSection], sectionEnd[MRVerSection]);
+    std::vector<SVFGBinMRVer> binVers(verCursor.count(3 * sizeof(u32_t)));
+    for (SVFGBinMRVer& ver : binVers)
+    {
+        ver.pts = verCursor.u32();
+        ver.ssaVer = verCursor.u32();
+        u32_t defType = verCursor.u32();
+        if (ver.pts >= ptsList.size() || defType > MSSADEF::SSAPHI)
+            reportBadSVFGBinary(filename, "invalid memory region version");
+        ver.defType = static_cast<MSSADEF::DEFTYPE>(defType);
+    }
+    if (verCursor.isTruncated() || !verCursor.atEnd())
+        reportBadSVFGBinary(filename, "truncated memory region version section");
+
+    ICFG* icfg = pag->getICFG();
+    SVFGBinCursor nodeCursor(sectionBegin[NodeSection], sectionEnd[NodeSection]);
+    std::vector<SVFGBinNode> binNodes(nodeCursor.count(4 * sizeof(u32_t)));
+    Set<NodeID> binNodeIds;
+    for (SVFGBinNode& node : binNodes)
+    {
+        u32_t kind = nodeCursor.u32();
+        node.id = nodeCursor.u32();
+        node.icfgNode = nodeCursor.u32();
+        node.mrver = nodeCursor.u32();
+        if (kind > BinMSSAPHI || node.mrver >= binVers.size() || !icfg->hasICFGNode(node.icfgNode) ||
+                hasSVFGNode(node.id) || !binNodeIds.insert(node.id).second)
+            reportBadSVFGBinary(filename, "invalid node " + std::to_string(node.id));
+        node.kind = static_cast<SVFGBinNodeK>(kind);
+        const ICFGNode* icfgNode = icfg->getICFGNode(node.icfgNode);
+        bool validICFGNode = true;
+        switch (node.kind)
+        {
+        case BinFormalIN:
+            validICFGNode = SVFUtil::isa<FunEntryICFGNode>(icfgNode);
+            break;
+        case BinFormalOUT:
+            validICFGNode = SVFUtil::isa<FunExitICFGNode>(icfgNode);
+            break;
+        case BinActualIN:
+        case BinActualOUT:
+            validICFGNode = SVFUtil::isa<CallICFGNode>(icfgNode);
+            break;
+        case BinMSSAPHI:
+            for (u32_t op = nodeCursor.count(2 * sizeof(u32_t)); op > 0; --op)
+            {
+                u32_t pos = nodeCursor.u32();
+                u32_t opVer = nodeCursor.u32();
+                if (opVer >= binVers.size())
+                    reportBadSVFGBinary(filename, "invalid operand of node " + std::to_string(node.id));
+                node.opVers.emplace_back(pos, opVer);
+            }
+            break;
+        }
+        if (!validICFGNode)
+            reportBadSVFGBinary(filename, "invalid ICFG node of node " + std::to_string(node.id));
+    }
+    if (nodeCursor.isTruncated() || !nodeCursor.atEnd())
+        reportBadSVFGBinary(filename, "truncated node section");
+
+    SVFGBinCursor edgeCursor(sectionBegin[EdgeSection], sectionEnd[EdgeSection]);
+    std::vector<SVFGBinEdge> binEdges(edgeCursor.count(5 * sizeof(u32_t)));
+    for (SVFGBinEdge& edge : binEdges)
+    {
+        u32_t kind = edgeCursor.u32();
+        edge.src = edgeCursor.u32();
+        edge.dst = edgeCursor.u32();
+        edge.pts = edgeCursor.u32();
+        edge.csId = edgeCursor.u32();
+        bool validKind = kind == SVFGEdge::IntraIndirectVF || kind == SVFGEdge::CallIndVF ||
+                         kind == SVFGEdge::RetIndVF || kind == SVFGEdge::TheadMHPIndirectVF;
+        bool validEnds = (hasSVFGNode(edge.src) || binNodeIds.count(edge.src)) &&
+                         (hasSVFGNode(edge.dst) || binNodeIds.count(edge.dst));
+        if (!validKind || !validEnds || edge.pts >= ptsList.size())
+            reportBadSVFGBinary(filename, "invalid edge " + std::to_string(edge.src) + " => " + std::to_string(edge.dst));
+        edge.kind = static_cast<SVFGEdge::SVFGEdgeK>(kind);
+    }
+    if (edgeCursor.isTruncated() || !edgeCursor.atEnd())
+        reportBadSVFGBinary(filename, "truncated edge section");
+
+    PAGEdge::PAGEdgeSetTy& stores = getPAGEdgeSet(PAGEdge::Store);
+    for (PAGEdge::PAGEdgeSetTy::iterator iter = stores.begin(), eiter =
+                stores.end(); iter != eiter; ++iter)
+    {
+        StoreStmt* store = SVFUtil::cast<StoreStmt>(*iter);
+        const StmtSVFGNode* sNode = getStmtVFGNode(store);
+        for(CHISet::iterator pi = mssa->getCHISet(store).begin(), epi = mssa->getCHISet(store).end(); pi!=epi; ++pi)
+            setDef((*pi)->getResVer(),sNode);
+    }
+
+    stat->ATVFNodeStart();
+    /// One memory region per distinct region points-to set
+    Map<u32_t, const MemRegion*> ptsToMR;
+    std::vector<const MRVer*> mrvers;
+    mrvers.reserve(binVers.size());
+    for (const SVFGBinMRVer& binVer : binVers)
+    {
+        const MemRegion*& mr = ptsToMR[binVer.pts];
+        if (mr == nullptr)
+        {
+            loadedMRs.emplace_back(new MemRegion(ptsList[binVer.pts]));
+            mr = loadedMRs.back().get();
+        }
+        loadedDefs.emplace_back(new MSSADEF(binVer.defType, mr));
+        loadedMRVers.emplace_back(new MRVer(mr, binVer.ssaVer, loadedDefs.back().get()));
+        mrvers.push_back(loadedMRVers.back().get());
+    }
+
+    for (const SVFGBinNode& node : binNodes)
+    {
+        ICFGNode* icfgNode = icfg->getICFGNode(node.icfgNode);
+        const MRVer* ver = mrvers[node.mrver];
+        switch (node.kind)
+        {
+        case BinFormalIN:
+            addFormalINSVFGNode(SVFUtil::cast<FunEntryICFGNode>(icfgNode), ver, node.id);
+            break;
+        case BinFormalOUT:
+            addFormalOUTSVFGNode(SVFUtil::cast<FunExitICFGNode>(icfgNode), ver, node.id);
+            break;
+        case BinActualIN:
+            addActualINSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), ver, node.id);
+            break;
+        case BinActualOUT:
+            addActualOUTSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), ver, node.id);
+            break;
+        case BinMSSAPHI:
+        {
+            Map<u32_t,const MRVer*> opVers;
+            for (const auto& op : node.opVers)
+                opVers[op.first] = mrvers[op.second];
+            addIntraMSSAPHISVFGNode(icfgNode, opVers.begin(), opVers.end(), ver, node.id);
+            break;
+        }
+        }
+        if (totalVFGNode <= node.id)
+            totalVFGNode = node.id + 1;
+    }
+    stat->ATVFNodeEnd();
+
+    stat->indVFEdgeStart();
+    for (const SVFGBinEdge& edge : binEdges)
+    {
+        const NodeBS& pts = ptsList[edge.pts];
+        switch (edge.kind)
+        {
+        case SVFGEdge::IntraIndirectVF:
+            addIntraIndirectVFEdge(edge.src, edge.dst, pts);
+            break;
+        case SVFGEdge::CallIndVF:
+            addCallIndirectVFEdge(edge.src, edge.dst, pts, edge.csId);
+            break;
+        case SVFGEdge::RetIndVF:
+            addRetIndirectVFEdge(edge.src, edge.dst, pts, edge.csId);
+            break;
+        default:
+            addThreadMHPIndirectVFEdge(edge.src, edge.dst, pts);
+            break;
+        }
+    }
+    stat->indVFEdgeEnd();
+
+    munmap(mapped, fileSize);
+    outs() << "\n";
+}
+
 // Format of file
 // __Nodes__
 // SVFGNodeID: <id> >= <node type> >= MVER: {MRVERID: <id> MemRegion: pts{<pts> } MRVERSION: <version> MSSADef: <version>, pts{<pts> }} >= ICFGNodeID: <id>
@@ -46,6 +589,11 @@ using namespace std;
 // srcSVFGNodeID: <id> => dstSVFGNodeID: <id> >= <edge type> | MVER: {MRVERID: <id> MemRegion: pts{<pts> } MRVERSION: <version> MSSADef: <version>, pts{<pts> }}
 void SVFG::writeToFile(const string& filename)
 {
+    if (Options::WriteSVFGBinary())
+    {
+        writeBinaryFile(filename);
+        return;
+    }
     outs() << "Writing SVFG analysis to '" << filename << "'...";
     error_code err;
     std::fstream f(filename.c_str(), std::ios_base::out);
@@ -206,6 +754,11 @@ void SVFG::writeToFile(const string& filename)
 
 void SVFG::readFile(const string& filename)
 {
+    if (isBinaryFile(filename))
+    {
+        readBinaryFile(filename);
+        return;
+    }
     outs() << "Loading SVFG analysis results from '" << filename << "'...";
     ifstream F(filename.c_str());
     if (!F.is_open())
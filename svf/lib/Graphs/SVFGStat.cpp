@@ -143,6 +143,11 @@ SVFGStat::SVFGStat(SVFG* g) : PTAStat(nullptr)
     addTopLevelNodeTimeStart = addTopLevelNodeTimeEnd = 0;
     addAddrTakenNodeTimeStart = addAddrTakenNodeTimeEnd = 0;
     svfgOptTimeStart = svfgOptTimeEnd = 0;
+    interOptTimeStart = interOptTimeEnd = 0;
+    intraOptTimeStart = intraOptTimeEnd = 0;
+    numOfInterOptRemoved = numOfIntraOptRemoved = 0;
+    readSVFGTimeStart = readSVFGTimeEnd = 0;
+    writeSVFGTimeStart = writeSVFGTimeEnd = 0;
 }
 
 void SVFGStat::clear()
@@ -195,6 +200,18 @@ void SVFGStat::performStat()
 
     timeStatMap["OptTime"] = (svfgOptTimeEnd - svfgOptTimeStart)/TIMEINTERVAL;
 
+    timeStatMap["OptInterTime"] = (interOptTimeEnd - interOptTimeStart)/TIMEINTERVAL;
+
+    timeStatMap["OptIntraTime"] = (intraOptTimeEnd - intraOptTimeStart)/TIMEINTERVAL;
+
+    PTNumStatMap["OptRmInterNode"] = numOfInterOptRemoved;
+
+    PTNumStatMap["OptRmPHINode"] = numOfIntraOptRemoved;
+
+    timeStatMap["ReadSVFGTime"] = (readSVFGTimeEnd - readSVFGTimeStart)/TIMEINTERVAL;
+
+    timeStatMap["WriteSVFGTime"] = (writeSVFGTimeEnd - writeSVFGTimeStart)/TIMEINTERVAL;
+
     PTNumStatMap["TotalNode"] = numOfNodes;
 
     PTNumStatMap["FormalIn"] = numOfFormalIn;
@@ -33,6 +33,10 @@
  */
 
 #include "MSSA/MemPartition.h"
+#include "Util/Options.h"
+
+#include <atomic>
+#include <thread>
 
 using namespace SVF;
 
@@ -101,10 +105,9 @@ void DistinctMRG::getMRsForLoad(MRSet& mrs, const NodeBS& pts, const SVFFunction
         NodeBS newPts;
         newPts.set(id);
 
-        MemRegion mr(newPts);
-        MRSet::iterator mit = memRegSet.find(&mr);
-        assert(mit!=memRegSet.end() && "memory region not found!!");
-        mrs.insert(*mit);
+        const MemRegion* mr = findMR(newPts);
+        assert(mr && "memory region not found!!");
+        mrs.insert(mr);
     }
 }
 
@@ -121,21 +124,52 @@ void DistinctMRG::getMRsForCallSiteRef(MRSet& aliasMRs, const NodeBS& cpts, cons
 
 void IntraDisjointMRG::partitionMRs()
 {
+    /// Intersections of different functions are independent, so they are
+    /// computed in parallel (Options::MSSAThreads). Lists are created up front
+    /// so workers never insert into funcToInterMap.
+    std::vector<std::pair<const PointsToList*, PointsToList*>> jobs;
     for(FunToPointsTosMap::iterator it = getFunToPointsToList().begin(),
             eit = getFunToPointsToList().end(); it!=eit; ++it)
     {
-        const SVFFunction* fun = it->first;
+        jobs.push_back(std::make_pair(&it->second, &getIntersList(it->first)));
+    }
 
-        for(PointsToList::iterator cit = it->second.begin(), ecit = it->second.end();
+    auto computeFunIntersections = [this](const PointsToList& cptsList, PointsToList& inters)
+    {
+        for(PointsToList::const_iterator cit = cptsList.begin(), ecit = cptsList.end();
                 cit!=ecit; ++cit)
         {
-            const NodeBS& cpts = *cit;
+            computeIntersections(*cit, inters);
+        }
+    };
 
-            PointsToList& inters = getIntersList(fun);
-            computeIntersections(cpts, inters);
+    const u32_t numThreads = std::min<u32_t>(Options::MSSAThreads(), jobs.size());
+    if (numThreads <= 1)
+    {
+        for (const std::pair<const PointsToList*, PointsToList*> &job : jobs)
+            computeFunIntersections(*job.first, *job.second);
+    }
+    else
+    {
+        std::atomic<size_t> nextJob(0);
+        std::vector<std::thread> workers;
+        for (u32_t t = 0; t < numThreads; ++t)
+        {
+            workers.push_back(std::thread([&]()
+            {
+                for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+                    computeFunIntersections(*jobs[i].first, *jobs[i].second);
+            }));
         }
 
-        /// Create memory regions.
+        for (std::thread &worker : workers) worker.join();
+    }
+
+    /// Create memory regions.
+    for(FunToPointsTosMap::iterator it = getFunToPointsToList().begin(),
+            eit = getFunToPointsToList().end(); it!=eit; ++it)
+    {
+        const SVFFunction* fun = it->first;
         const PointsToList& inters = getIntersList(fun);
         for (PointsToList::const_iterator interIt = inters.begin(), interEit = inters.end();
                 interIt != interEit; ++interIt)
@@ -143,6 +177,8 @@ void IntraDisjointMRG::partitionMRs()
             const NodeBS& inter = *interIt;
             createDisjointMR(fun, inter);
         }
+
+        indexInters(inters, getObjToMRMap(fun));
     }
 }
 
@@ -238,20 +274,32 @@ void IntraDisjointMRG::createDisjointMR(const SVFFunction* func, const NodeBS& c
     createMR(func, cpts);
 }
 
-void IntraDisjointMRG::getMRsForLoadFromInterList(MRSet& mrs, const NodeBS& cpts, const PointsToList& inters)
+void IntraDisjointMRG::indexInters(const PointsToList& inters, ObjToMRMap& objToMR) const
 {
-    PointsToList::const_iterator it = inters.begin();
-    PointsToList::const_iterator eit = inters.end();
-    for (; it != eit; ++it)
+    for (const NodeBS& inter : inters)
     {
-        const NodeBS& inter = *it;
-        if (cpts.contains(inter))
-        {
-            MemRegion mr(inter);
-            MRSet::iterator mit = memRegSet.find(&mr);
-            assert(mit!=memRegSet.end() && "memory region not found!!");
-            mrs.insert(*mit);
-        }
+        const MemRegion* mr = findMR(inter);
+        assert(mr && "memory region not found!!");
+        for (NodeID o : inter) objToMR[o] = mr;
+    }
+}
+
+/**
+ * Intersections are disjoint, so each object of cpts is in at most one of
+ * them and only those regions need to be checked, rather than every
+ * intersection of the function.
+ */
+void IntraDisjointMRG::getMRsForLoadFromInterList(MRSet& mrs, const NodeBS& cpts, const ObjToMRMap& objToMR)
+{
+    Set<const MemRegion*> checked;
+    for (NodeID o : cpts)
+    {
+        ObjToMRMap::const_iterator it = objToMR.find(o);
+        if (it == objToMR.end()) continue;
+
+        const MemRegion* mr = it->second;
+        if (checked.insert(mr).second && cpts.contains(mr->getPointsTo()))
+            mrs.insert(mr);
     }
 }
 
@@ -281,6 +329,13 @@ void InterDisjointMRG::partitionMRs()
         }
     }
 
+    /// Intersections are disjoint, so each object is in at most one of them.
+    Map<NodeID, const NodeBS*> objToInter;
+    for (const NodeBS& inter : inters)
+    {
+        for (NodeID o : inter) objToInter[o] = &inter;
+    }
+
     /// Create memory regions.
     for(FunToPointsTosMap::iterator it = getFunToPointsToList().begin(),
             eit = getFunToPointsToList().end(); it!=eit; ++it)
@@ -292,13 +347,19 @@ void InterDisjointMRG::partitionMRs()
         {
             const NodeBS& cpts = *cit;
 
-            for (PointsToList::const_iterator interIt = inters.begin(), interEit = inters.end();
-                    interIt != interEit; ++interIt)
+            /// Only the intersections of cpts's objects can be contained in cpts.
+            Set<const NodeBS*> checked;
+            for (NodeID o : cpts)
             {
-                const NodeBS& inter = *interIt;
-                if (cpts.contains(inter))
+                Map<NodeID, const NodeBS*>::const_iterator interIt = objToInter.find(o);
+                if (interIt == objToInter.end()) continue;
+
+                const NodeBS& inter = *interIt->second;
+                if (checked.insert(&inter).second && cpts.contains(inter))
                     createDisjointMR(fun, inter);
             }
         }
     }
+
+    indexInters(inters, objToMR);
 }
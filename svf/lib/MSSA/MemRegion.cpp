@@ -57,6 +57,8 @@ void MRGenerator::destroy()
     {
         delete *it;
     }
+    memRegSet.clear();
+    cptsToMRMap.clear();
 
     delete callGraphSCC;
     callGraphSCC = nullptr;
@@ -70,19 +72,15 @@ void MRGenerator::destroy()
 void MRGenerator::createMR(const SVFFunction* fun, const NodeBS& cpts)
 {
     const NodeBS& repCPts = getRepPointsTo(cpts);
-    MemRegion mr(repCPts);
-    MRSet::const_iterator mit = memRegSet.find(&mr);
-    if(mit!=memRegSet.end())
+    if(const MemRegion* mr = findMR(repCPts))
     {
-        const MemRegion* mr = *mit;
-        MRSet& mrs = funToMRsMap[fun];
-        if(mrs.find(mr)==mrs.end())
-            mrs.insert(mr);
+        funToMRsMap[fun].insert(mr);
     }
     else
     {
         MemRegion* m = new MemRegion(repCPts);
         memRegSet.insert(m);
+        cptsToMRMap[repCPts] = m;
         funToMRsMap[fun].insert(m);
     }
 }
@@ -92,10 +90,9 @@ void MRGenerator::createMR(const SVFFunction* fun, const NodeBS& cpts)
  */
 const MemRegion* MRGenerator::getMR(const NodeBS& cpts) const
 {
-    MemRegion mr(getRepPointsTo(cpts));
-    MRSet::iterator mit = memRegSet.find(&mr);
-    assert(mit!=memRegSet.end() && "memory region not found!!");
-    return *mit;
+    const MemRegion* mr = findMR(getRepPointsTo(cpts));
+    assert(mr && "memory region not found!!");
+    return mr;
 }
 
 
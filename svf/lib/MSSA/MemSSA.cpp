@@ -33,6 +33,9 @@
 #include "Graphs/SVFGStat.h"
 #include "Graphs/CallGraph.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace SVF;
 using namespace SVFUtil;
 
@@ -44,7 +47,7 @@ double MemSSA::timeOfSSARenaming  = 0;	///< Time for SSA rename
 /*!
  * Constructor
  */
-MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA)
+MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA) : funWorker(false)
 {
     pta = p;
     assert((pta->getAnalysisTy()!=PointerAnalysis::Default_PTA)
@@ -69,6 +72,17 @@ MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA)
     timeOfGeneratingMemRegions = (mrEnd - mrStart)/TIMEINTERVAL;
 }
 
+/*!
+ * Constructor of a per-function worker.
+ * Memory regions are those of the parent.
+ */
+MemSSA::MemSSA(const MemSSA* parent) : funWorker(true)
+{
+    pta = parent->pta;
+    mrGen = parent->mrGen;
+    stat = parent->stat;
+}
+
 SVFIR* MemSSA::getPAG()
 {
     return pta->getPAG();
@@ -78,6 +92,11 @@ SVFIR* MemSSA::getPAG()
  * Start building memory SSA
  */
 void MemSSA::buildMemSSA(const SVFFunction& fun)
+{
+    buildMemSSA(fun, timeOfCreateMUCHI, timeOfInsertingPHI, timeOfSSARenaming);
+}
+
+void MemSSA::buildMemSSA(const SVFFunction& fun, double& muchiTime, double& phiTime, double& renameTime)
 {
 
     assert(!isExtCall(&fun) && "we do not build memory ssa for external functions");
@@ -92,20 +111,94 @@ void MemSSA::buildMemSSA(const SVFFunction& fun)
     double muchiStart = stat->getClk(true);
     createMUCHI(fun);
     double muchiEnd = stat->getClk(true);
-    timeOfCreateMUCHI += (muchiEnd - muchiStart)/TIMEINTERVAL;
+    muchiTime += (muchiEnd - muchiStart)/TIMEINTERVAL;
 
     /// Insert PHI for memory regions
     double phiStart = stat->getClk(true);
     insertPHI(fun);
     double phiEnd = stat->getClk(true);
-    timeOfInsertingPHI += (phiEnd - phiStart)/TIMEINTERVAL;
+    phiTime += (phiEnd - phiStart)/TIMEINTERVAL;
 
     /// SSA rename for memory regions
     double renameStart = stat->getClk(true);
     SSARename(fun);
     double renameEnd = stat->getClk(true);
-    timeOfSSARenaming += (renameEnd - renameStart)/TIMEINTERVAL;
+    renameTime += (renameEnd - renameStart)/TIMEINTERVAL;
+
+}
+
+/*!
+ * Build memory SSA for each function in funs in parallel.
+ * Once memory regions are generated, mu/chi creation, phi insertion and
+ * renaming of a function only read the regions, so each function is built by
+ * a separate worker (with its own version counters and stacks) and the
+ * results are merged afterwards in the order of funs. The result is the same
+ * as calling buildMemSSA on each function in that order.
+ * Phase times are summed over all threads.
+ */
+void MemSSA::buildMemSSAInParallel(const std::vector<const SVFFunction*>& funs)
+{
+    // Region lookups of loads/stores insert into the region maps when absent.
+    // Make sure they are all present so workers only read.
+    SVFIR* pag = getPAG();
+    for (const SVFStmt* load : pag->getSVFStmtSet(SVFStmt::Load))
+        mrGen->getLoadMRSet(SVFUtil::cast<LoadStmt>(load));
+    for (const SVFStmt* store : pag->getSVFStmtSet(SVFStmt::Store))
+        mrGen->getStoreMRSet(SVFUtil::cast<StoreStmt>(store));
+
+    const u32_t numThreads = std::max<u32_t>(1, std::min<u32_t>(Options::MSSAThreads(), funs.size()));
+    std::vector<std::unique_ptr<MemSSA>> funMSSAs(funs.size());
+    std::vector<double> muchiTimes(numThreads, 0), phiTimes(numThreads, 0), renameTimes(numThreads, 0);
+    std::atomic<size_t> nextFun(0);
+
+    std::vector<std::thread> workers;
+    for (u32_t t = 0; t < numThreads; ++t)
+    {
+        workers.push_back(std::thread([&, t]()
+        {
+            for (size_t i = nextFun++; i < funs.size(); i = nextFun++)
+            {
+                funMSSAs[i] = std::unique_ptr<MemSSA>(new MemSSA(this));
+                funMSSAs[i]->buildMemSSA(*funs[i], muchiTimes[t], phiTimes[t], renameTimes[t]);
+            }
+        }));
+    }
+
+    for (std::thread &worker : workers) worker.join();
+
+    for (std::unique_ptr<MemSSA> &funMSSA : funMSSAs) mergeFunMSSA(*funMSSA);
 
+    for (u32_t t = 0; t < numThreads; ++t)
+    {
+        timeOfCreateMUCHI += muchiTimes[t];
+        timeOfInsertingPHI += phiTimes[t];
+        timeOfSSARenaming += renameTimes[t];
+    }
+}
+
+/*!
+ * Take over everything funMSSA built, numbering its versions as a
+ * sequential build would have.
+ */
+void MemSSA::mergeFunMSSA(MemSSA& funMSSA)
+{
+    assert(funMSSA.funWorker && "merging a MemSSA which is not a per-function worker?");
+
+    for (std::unique_ptr<MRVer> &mrVer : funMSSA.usedMRVers)
+    {
+        mrVer->vid = MRVer::totalVERNum++;
+        usedMRVers.push_back(std::move(mrVer));
+    }
+    funMSSA.usedMRVers.clear();
+
+    // Functions are disjoint, so no key is in both; merge leaves funMSSA's maps empty.
+    load2MuSetMap.merge(funMSSA.load2MuSetMap);
+    store2ChiSetMap.merge(funMSSA.store2ChiSetMap);
+    callsiteToMuSetMap.merge(funMSSA.callsiteToMuSetMap);
+    callsiteToChiSetMap.merge(funMSSA.callsiteToChiSetMap);
+    bb2PhiSetMap.merge(funMSSA.bb2PhiSetMap);
+    funToEntryChiSetMap.merge(funMSSA.funToEntryChiSetMap);
+    funToReturnMuSetMap.merge(funMSSA.funToReturnMuSetMap);
 }
 
 /*!
@@ -353,7 +446,9 @@ MRVer* MemSSA::newSSAName(const MemRegion* mr, MSSADEF* def)
 
     MRVERSION version = mr2CounterMap[mr];
     mr2CounterMap[mr] = version + 1;
-    auto mrVer = std::make_unique<MRVer>(mr, version, def);
+    // Workers leave global IDs to mergeFunMSSA.
+    auto mrVer = funWorker ? std::make_unique<MRVer>(mr, version, def, 0)
+                 : std::make_unique<MRVer>(mr, version, def);
     auto mrVerPtr = mrVer.get();
     mr2VerStackMap[mr].push_back(mrVerPtr);
     usedMRVers.push_back(std::move(mrVer));
@@ -436,9 +531,13 @@ void MemSSA::destroy()
         }
     }
 
-    delete mrGen;
+    // Workers share these with the MemSSA they are merged into.
+    if (!funWorker)
+    {
+        delete mrGen;
+        delete stat;
+    }
     mrGen = nullptr;
-    delete stat;
     stat = nullptr;
     pta = nullptr;
 }
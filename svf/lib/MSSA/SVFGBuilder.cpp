@@ -104,6 +104,7 @@ std::unique_ptr<MemSSA> SVFGBuilder::buildMSSA(BVDataPTAImpl* pta, bool ptrOnlyM
     auto mssa = std::make_unique<MemSSA>(pta, ptrOnlyMSSA);
 
     CallGraph* svfirCallGraph = PAG::getPAG()->getCallGraph();
+    std::vector<const SVFFunction*> funs;
     for (const auto& item: *svfirCallGraph)
     {
 
@@ -111,7 +112,15 @@ std::unique_ptr<MemSSA> SVFGBuilder::buildMSSA(BVDataPTAImpl* pta, bool ptrOnlyM
         if (isExtCall(fun))
             continue;
 
-        mssa->buildMemSSA(*fun);
+        funs.push_back(fun);
+    }
+
+    if (Options::MSSAThreads() > 1)
+        mssa->buildMemSSAInParallel(funs);
+    else
+    {
+        for (const SVFFunction* fun : funs)
+            mssa->buildMemSSA(*fun);
     }
 
     mssa->performStat();
@@ -127,6 +127,19 @@ void BVDataPTAImpl::finalize()
 
 }
 
+u64_t BVDataPTAImpl::sweepPtCache(void)
+{
+    PTDataTy *ptd = ptD.get();
+    // PersDFPTDataTy also covers PersIncDFPTDataTy.
+    if (const PersDFPTDataTy *df = SVFUtil::dyn_cast<PersDFPTDataTy>(ptd)) df->markLivePts();
+    else if (const PersVersionedPTDataTy *v = SVFUtil::dyn_cast<PersVersionedPTDataTy>(ptd)) v->markLivePts();
+    else if (const PersDiffPTDataTy *diff = SVFUtil::dyn_cast<PersDiffPTDataTy>(ptd)) diff->markLivePts();
+    else if (const PersPTDataTy *base = SVFUtil::dyn_cast<PersPTDataTy>(ptd)) base->markLivePts();
+    else return 0;
+
+    return ptCache.sweep();
+}
+
 /*!
  * Expand all fields of an aggregate in all points-to sets
  */
@@ -171,17 +184,7 @@ void BVDataPTAImpl::writeObjVarToFile(const string& filename)
     }
 
     // Write BaseNodes insensitivity to file
-    NodeBS NodeIDs;
-    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
-    {
-        PAGNode* pagNode = it->second;
-        if (!isa<ObjVar>(pagNode)) continue;
-        NodeID n = pag->getBaseObjVar(it->first);
-        if (NodeIDs.test(n)) continue;
-        f << n << " ";
-        f << isFieldInsensitive(n) << "\n";
-        NodeIDs.set(n);
-    }
+    writeObjFieldSensitivityToFile(f);
 
     f << "------\n";
 
@@ -195,6 +198,21 @@ void BVDataPTAImpl::writeObjVarToFile(const string& filename)
 
 }
 
+void BVDataPTAImpl::writeObjFieldSensitivityToFile(std::fstream& f)
+{
+    NodeBS NodeIDs;
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+    {
+        PAGNode* pagNode = it->second;
+        if (!isa<ObjVar>(pagNode)) continue;
+        NodeID n = pag->getBaseObjVar(it->first);
+        if (NodeIDs.test(n)) continue;
+        f << n << " ";
+        f << isFieldInsensitive(n) << "\n";
+        NodeIDs.set(n);
+    }
+}
+
 void BVDataPTAImpl::writePtsResultToFile(std::fstream& f)
 {
     // Write analysis results to file
@@ -265,17 +283,7 @@ void BVDataPTAImpl::writeToFile(const string& filename)
     f << "------\n";
 
     // Write BaseNodes insensitivity to file
-    NodeBS NodeIDs;
-    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
-    {
-        PAGNode* pagNode = it->second;
-        if (!isa<ObjVar>(pagNode)) continue;
-        NodeID n = pag->getBaseObjVar(it->first);
-        if (NodeIDs.test(n)) continue;
-        f << n << " ";
-        f << isFieldInsensitive(n) << "\n";
-        NodeIDs.set(n);
-    }
+    writeObjFieldSensitivityToFile(f);
 
     // Job finish and close file
     f.close();
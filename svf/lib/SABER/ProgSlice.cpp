@@ -28,6 +28,7 @@
  */
 
 #include "SABER/ProgSlice.h"
+#include "Util/Options.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -61,22 +62,33 @@ bool ProgSlice::AllPathReachableSolve()
             const SVFGNode* succ = edge->getDstNode();
             if(inBackwardSlice(succ))
             {
-                Condition vfCond;
-                const SVFBasicBlock* nodeBB = getSVFGNodeBB(node);
-                const SVFBasicBlock* succBB = getSVFGNodeBB(succ);
-                /// clean up the control flow conditions for next round guard computation
-                clearCFCond();
+                /// give up, the caller reports the slice as unknown
+                if (!chargeGuard())
+                    return false;
 
-                if(edge->isCallVFGEdge())
-                {
-                    vfCond = ComputeInterCallVFGGuard(nodeBB,succBB, getCallSite(edge)->getParent());
-                }
-                else if(edge->isRetVFGEdge())
+                Condition vfCond;
+                bool shared = Options::SaberSharedSlice();
+                if (!shared || !pathAllocator->getCachedVFGuard(edge, vfCond))
                 {
-                    vfCond = ComputeInterRetVFGGuard(nodeBB,succBB, getRetSite(edge)->getParent());
+                    const SVFBasicBlock* nodeBB = getSVFGNodeBB(node);
+                    const SVFBasicBlock* succBB = getSVFGNodeBB(succ);
+                    /// clean up the control flow conditions for next round guard computation
+                    clearCFCond();
+
+                    if(edge->isCallVFGEdge())
+                    {
+                        vfCond = ComputeInterCallVFGGuard(nodeBB,succBB, getCallSite(edge)->getParent());
+                    }
+                    else if(edge->isRetVFGEdge())
+                    {
+                        vfCond = ComputeInterRetVFGGuard(nodeBB,succBB, getRetSite(edge)->getParent());
+                    }
+                    else
+                        vfCond = ComputeIntraVFGGuard(nodeBB,succBB);
+                    if (shared)
+                        pathAllocator->cacheVFGuard(edge, vfCond);
                 }
-                else
-                    vfCond = ComputeIntraVFGGuard(nodeBB,succBB);
+                /// the invalid condition depends on the backward slice, so it is not cached
                 vfCond = condAnd(vfCond, condNeg(invalidCond));
                 Condition succPathCond = condAnd(cond, vfCond);
                 if(setVFCond(succ,  condOr(getVFCond(succ), succPathCond) ))
@@ -176,6 +188,38 @@ bool ProgSlice::isSatisfiableForPairs()
     return true;
 }
 
+void ProgSlice::moveToAllocator(SaberCondAllocator* pa)
+{
+    pathAllocator = pa;
+    if (SaberCondition::useBDD)
+        return;
+
+    SVFGNodeToCondMap sinkConds;
+    for (const SVFGNode* sink : sinks)
+    {
+        SVFGNodeToCondMap::const_iterator it = svfgNodeToCondMap.find(sink);
+        if (it != svfgNodeToCondMap.end())
+            sinkConds.emplace(sink, Z3Expr::translate(it->second.getExpr()));
+    }
+    svfgNodeToCondMap.swap(sinkConds);
+    finalCond = Z3Expr::translate(finalCond.getExpr());
+}
+
+std::string ProgSlice::getBudgetName(BudgetKind kind)
+{
+    switch (kind)
+    {
+    case NodeBudget:
+        return "node";
+    case GuardBudget:
+        return "guard";
+    case TimeBudget:
+        return "time";
+    default:
+        return "none";
+    }
+}
+
 const CallICFGNode* ProgSlice::getCallSite(const SVFGEdge* edge) const
 {
     assert(edge->isCallVFGEdge() && "not a call svfg edge?");
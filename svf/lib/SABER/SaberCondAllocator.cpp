@@ -40,17 +40,38 @@
 using namespace SVF;
 using namespace SVFUtil;
 
-u64_t DPItem::maximumBudget = ULONG_MAX - 1;
+thread_local u64_t DPItem::maximumBudget = ULONG_MAX - 1;
 u32_t ContextCond::maximumCxtLen = 0;
-u32_t ContextCond::maximumCxt = 0;
+std::atomic<u32_t> ContextCond::maximumCxt(0);
 u32_t ContextCond::maximumPathLen = 0;
-u32_t ContextCond::maximumPath = 0;
+std::atomic<u32_t> ContextCond::maximumPath(0);
 u32_t SaberCondAllocator::totalCondNum = 0;
+bool SaberCondition::useBDD = false;
 
 
 SaberCondAllocator::SaberCondAllocator()
 {
+    SaberCondition::useBDD = Options::SaberBDD();
+}
 
+/*!
+ * Copy the branch conditions into the context of the calling thread. Conditions
+ * of the copy are never mapped back to their terminators, a slice translates its
+ * final condition back into the shared context before it is reported.
+ */
+SaberCondAllocator* SaberCondAllocator::newThreadAllocator() const
+{
+    assert(!SaberCondition::useBDD && "BDDs share a single manager");
+    SaberCondAllocator* allocator = new SaberCondAllocator();
+    allocator->funToExitBBsMap = funToExitBBsMap;
+    allocator->removedSUVFEdges = removedSUVFEdges;
+    for (const auto& bbCond : bbConds)
+    {
+        CondPosMap& condPosMap = allocator->bbConds[bbCond.first];
+        for (const auto& posCond : bbCond.second)
+            condPosMap.emplace(posCond.first, Z3Expr::translate(posCond.second.getExpr()));
+    }
+    return allocator;
 }
 
 /*!
@@ -602,10 +623,14 @@ void SaberCondAllocator::printPathCond()
 SaberCondAllocator::Condition SaberCondAllocator::newCond(const ICFGNode* inst)
 {
     u32_t condCountIdx = totalCondNum++;
-    Condition expr = Condition::getContext().bool_const(("c" + std::to_string(condCountIdx)).c_str());
+    Condition expr = SaberCondition::useBDD ? Condition(BDDExpr::newVar()) :
+                     Condition(Z3Expr::getContext().bool_const(("c" + std::to_string(condCountIdx)).c_str()));
     Condition negCond = Condition::NEG(expr);
     setCondInst(expr, inst);
     setNegCondInst(negCond, inst);
+    /// both literals stay referenced by conditionVec, so their BDD node ids are never reclaimed
+    if (SaberCondition::useBDD)
+        bddVarToCondIdx[BDDManager::getManager().getNumOfVars() - 1] = conditionVec.size();
     conditionVec.push_back(expr);
     conditionVec.push_back(negCond);
     return expr;
@@ -615,28 +640,44 @@ SaberCondAllocator::Condition SaberCondAllocator::newCond(const ICFGNode* inst)
 bool SaberCondAllocator::isEquivalentBranchCond(const Condition &lhs,
         const Condition &rhs) const
 {
-    Condition::getSolver().push();
-    Condition::getSolver().add(lhs.getExpr() != rhs.getExpr()); /// check equal using z3 solver
-    z3::check_result res = Condition::getSolver().check();
-    Condition::getSolver().pop();
-    return res == z3::unsat;
+    /// BDDs are canonical
+    if (SaberCondition::useBDD)
+        return eq(lhs, rhs);
+
+    /// check equal using z3 solver
+    return !Z3Expr::isSatisfiable(lhs.getExpr() != rhs.getExpr());
 }
 
 /// whether condition is satisfiable
 bool SaberCondAllocator::isSatisfiable(const Condition &condition)
 {
-    Condition::getSolver().add(condition.getExpr());
-    z3::check_result result = Condition::getSolver().check();
-    Condition::getSolver().pop();
-    if (result == z3::sat || result == z3::unknown)
-        return true;
-    else
-        return false;
+    if (SaberCondition::useBDD)
+        return !condition.getBDD().isFalse();
+
+    return Z3Expr::isSatisfiable(condition.getExpr());
 }
 
-/// extract subexpression from a Z3 expression
+/// extract subexpression from a condition
 void SaberCondAllocator::extractSubConds(const Condition &condition, NodeBS &support) const
 {
+    /// a variable of a BDD is a negated branch if the condition does not hold on its positive literal
+    if (SaberCondition::useBDD)
+    {
+        NodeBS vars;
+        BDDManager::getManager().support(condition.id(), vars);
+        for (u32_t var : vars)
+        {
+            Map<u32_t, u32_t>::const_iterator it = bddVarToCondIdx.find(var);
+            assert(it != bddVarToCondIdx.end() && "BDD variable not allocated by newCond?");
+            const Condition& posCond = conditionVec[it->second];
+            if (BDDExpr::AND(condition.getBDD(), posCond.getBDD()).isFalse())
+                support.set(conditionVec[it->second + 1].id());
+            else
+                support.set(posCond.id());
+        }
+        return;
+    }
+
     if (condition.getExpr().num_args() == 1 && isNegCond(condition.id()))
     {
         support.set(condition.getExpr().id());
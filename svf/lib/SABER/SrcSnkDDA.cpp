@@ -33,10 +33,16 @@
 #include "Graphs/SVFGStat.h"
 #include "Util/Options.h"
 #include "WPA/Andersen.h"
+#include "Util/SVFStat.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
 
+thread_local SrcSnkDDA::SliceState* SrcSnkDDA::workerState = nullptr;
+
 /// Initialize analysis
 void SrcSnkDDA::initialize(SVFModule* module)
 {
@@ -70,49 +76,248 @@ void SrcSnkDDA::analyze(SVFModule* module)
 
     ContextCond::setMaxCxtLen(Options::CxtLimit());
 
+    if (Options::SaberSinkReach())
+        buildSinkReachability();
+
+    if (Options::SaberThreads() > 1)
+    {
+        analyzeInParallel();
+        finalize();
+        return;
+    }
+
     for (SVFGNodeSetIter iter = sourcesBegin(), eiter = sourcesEnd();
             iter != eiter; ++iter)
     {
         setCurSlice(*iter);
 
         DBOUT(DGENERAL, outs() << "Analysing slice:" << (*iter)->getId() << ")\n");
-        ContextCond cxt;
-        DPIm item((*iter)->getId(),cxt);
-        forwardTraverse(item);
+        traverseCurSlice();
+        reportCurSlice(solveCurSlice());
+    }
+    finalize();
 
-        /// do not consider there is bug when reaching a global SVFGNode
-        /// if we touch a global, then we assume the client uses this memory until the program exits.
-        if (getCurSlice()->isReachGlobal())
-        {
-            DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << (*iter)->getId() << ")\n");
-        }
-        else
-        {
-            DBOUT(DSaber, outs() << "Forward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getForwardSliceSize() << ")\n");
+}
 
-            for (SVFGNodeSetIter sit = getCurSlice()->sinksBegin(), esit =
-                        getCurSlice()->sinksEnd(); sit != esit; ++sit)
+/*!
+ * Slice sources on Options::SaberThreads() workers.
+ * Each worker traverses its slices with its own SliceState. With z3 conditions, it
+ * also solves their guards in its own z3 context, on branch conditions translated
+ * from the shared allocator (SaberCondAllocator::newThreadAllocator). The shared
+ * context is not thread-safe, hence only translations from and into it, reporting
+ * bugs and deleting slices are serialised under condMutex: a worker finishing a
+ * slice translates its final condition back and reports every consecutive solved
+ * slice, so that bugs are reported in the order of sources as in the sequential
+ * analysis. BDD conditions live in a single manager, so with them creating slices
+ * and solving guards are serialised as well.
+ */
+void SrcSnkDDA::analyzeInParallel()
+{
+    std::vector<const SVFGNode*> srcs(sourcesBegin(), sourcesEnd());
+    std::vector<ProgSlice*> solvedSlices(srcs.size(), nullptr);
+    std::vector<char> guardsSolved(srcs.size(), false);
+    size_t nextReport = 0;
+    std::atomic<size_t> nextSrc(0);
+    std::mutex condMutex;
+    const bool ownContext = !SaberCondition::useBDD;
+
+    std::vector<std::thread> threads;
+    for (u32_t t = 0; t < Options::SaberThreads(); ++t)
+    {
+        threads.push_back(std::thread([&]()
+        {
+            SliceState state;
+            workerState = &state;
+            if (ownContext)
             {
-                ContextCond cxt;
-                DPIm item((*sit)->getId(),cxt);
-                backwardTraverse(item);
+                std::lock_guard<std::mutex> lock(condMutex);
+                Z3Expr::newThreadContext();
+                state.allocator.reset(getSaberCondAllocator()->newThreadAllocator());
             }
 
-            DBOUT(DSaber, outs() << "Backward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getBackwardSliceSize() << ")\n");
+            for (size_t i = nextSrc++; i < srcs.size(); i = nextSrc++)
+            {
+                std::unique_lock<std::mutex> lock(condMutex, std::defer_lock);
+                if (!ownContext)
+                    lock.lock();
+                state.slice = createSlice(srcs[i]);
+                if (!ownContext)
+                    lock.unlock();
+                clearVisitedMap();
+
+                DBOUT(DGENERAL, outs() << "Analysing slice:" << srcs[i]->getId() << ")\n");
+                traverseCurSlice();
+
+                if (!ownContext)
+                    lock.lock();
+                guardsSolved[i] = solveCurSlice();
+                if (ownContext)
+                {
+                    lock.lock();
+                    Z3Expr::enableThreadContext(false);
+                    state.slice->moveToAllocator(getSaberCondAllocator());
+                }
 
-            if(Options::DumpSlice())
-                annotateSlice(_curSlice);
+                solvedSlices[i] = state.slice;
+                for (; nextReport < solvedSlices.size() && solvedSlices[nextReport]; ++nextReport)
+                {
+                    state.slice = solvedSlices[nextReport];
+                    reportCurSlice(guardsSolved[nextReport]);
+                    delete state.slice;
+                }
+                state.slice = nullptr;
+                if (ownContext)
+                    Z3Expr::enableThreadContext(true);
+            }
 
-            if(_curSlice->AllPathReachableSolve())
-                _curSlice->setAllReachable();
+            if (ownContext)
+            {
+                std::lock_guard<std::mutex> lock(condMutex);
+                getSaberCondAllocator()->addThreadVFGuardStat(*state.allocator);
+                state.allocator.reset();
+                Z3Expr::releaseThreadContext();
+            }
+            workerState = nullptr;
+        }));
+    }
+    for (std::thread &thread : threads) thread.join();
+}
 
-            DBOUT(DSaber, outs() << "Guard computation for slice:" << (*iter)->getId() << ")\n");
+/*!
+ * Sweep the SVFG backward from all sinks. Edges are followed regardless of
+ * calling contexts, so a node outside the result cannot reach a sink along
+ * any realisable path either: a source outside it yields a slice without
+ * sinks, and the forward slice of other sources needs not enter it.
+ */
+void SrcSnkDDA::buildSinkReachability()
+{
+    double start = SVFStat::getClk(true);
+    sinkReachableNodes.clear();
+    FIFOWorkList<const SVFGNode*> worklist;
+    for (const SVFGNode* sink : getSinks())
+    {
+        if (sinkReachableNodes.test_and_set(sink->getId()))
+            worklist.push(sink);
+    }
+    while (!worklist.empty())
+    {
+        const SVFGNode* node = worklist.pop();
+        for (const SVFGEdge* edge : node->getInEdges())
+        {
+            if (sinkReachableNodes.test_and_set(edge->getSrcID()))
+                worklist.push(edge->getSrcNode());
         }
+    }
+    sinkReachBuilt = true;
+    sinkReachTime = SVFStat::getClk(true) - start;
+}
 
-        reportBug(getCurSlice());
+void SrcSnkDDA::traverseCurSlice()
+{
+    ProgSlice* slice = getCurSlice();
+    const SVFGNode* src = slice->getSource();
+
+    /// the slice of a source reaching no sink has no sinks, as after a full traversal
+    if (!mayReachSink(src))
+    {
+        numOfPrunedSources++;
+        DBOUT(DSaber, outs() << "No sink reachable from slice:" << src->getId() << ")\n");
+        return;
+    }
+
+    slice->resumeTimer();
+    ContextCond cxt;
+    DPIm item(src->getId(),cxt);
+    forwardTraverse(item);
+
+    /// do not consider there is bug when reaching a global SVFGNode
+    /// if we touch a global, then we assume the client uses this memory until the program exits.
+    if (slice->isReachGlobal())
+    {
+        DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << src->getId() << ")\n");
+        slice->pauseTimer();
+        return;
+    }
+    /// the sinks found so far are incomplete, the slice is reported as unknown
+    if (slice->isBudgetExhausted())
+    {
+        slice->pauseTimer();
+        return;
+    }
+
+    DBOUT(DSaber, outs() << "Forward process for slice:" << src->getId() << " (size = " << getCurSlice()->getForwardSliceSize() << ")\n");
+
+    for (SVFGNodeSetIter sit = getCurSlice()->sinksBegin(), esit =
+                getCurSlice()->sinksEnd(); sit != esit; ++sit)
+    {
+        ContextCond cxt;
+        DPIm item((*sit)->getId(),cxt);
+        backwardTraverse(item);
     }
-    finalize();
 
+    DBOUT(DSaber, outs() << "Backward process for slice:" << src->getId() << " (size = " << getCurSlice()->getBackwardSliceSize() << ")\n");
+    slice->pauseTimer();
+}
+
+bool SrcSnkDDA::solveCurSlice()
+{
+    ProgSlice* slice = getCurSlice();
+    if (slice->isReachGlobal() || slice->isBudgetExhausted())
+        return false;
+
+    slice->resumeTimer();
+    if(slice->AllPathReachableSolve())
+        slice->setAllReachable();
+    slice->pauseTimer();
+
+    DBOUT(DSaber, outs() << "Guard computation for slice:" << slice->getSource()->getId() << ")\n");
+    return true;
+}
+
+void SrcSnkDDA::reportCurSlice(bool solved)
+{
+    ProgSlice* slice = getCurSlice();
+    if(solved && Options::DumpSlice())
+        annotateSlice(slice);
+    recordSliceCost(slice);
+
+    if (slice->isBudgetExhausted())
+        reportUnknown(slice);
+    else
+        reportBug(slice);
+}
+
+void SrcSnkDDA::reportUnknown(ProgSlice* slice)
+{
+    const SVFGNode* src = slice->getSource();
+    unknownSources.emplace_back(src, slice->getExhaustedBudget());
+    SVFUtil::errs() << bugMsg3("\t Unknown :") << " source " << src->getId();
+    if (const ICFGNode* icfgNode = src->getICFGNode())
+        SVFUtil::errs() << " at : (" << icfgNode->getSourceLoc() << ")";
+    SVFUtil::errs() << ", " << ProgSlice::getBudgetName(slice->getExhaustedBudget())
+                    << " budget exhausted after " << slice->getNumOfVisitedNodes() << " nodes, "
+                    << slice->getNumOfGuards() << " guards\n";
+}
+
+/// Bucket of a cost in a histogram, 0 for 0 and i for [2^(i-1), 2^i)
+static u32_t getCostBucket(u64_t cost)
+{
+    u32_t bucket = 0;
+    for (; cost != 0; cost >>= 1)
+        bucket++;
+    return bucket;
+}
+
+void SrcSnkDDA::recordSliceCost(const ProgSlice* slice)
+{
+    u32_t nodeBucket = getCostBucket(slice->getNumOfVisitedNodes());
+    u32_t timeBucket = getCostBucket((u64_t)(slice->getElapsedTime() * 1000));
+    if (nodeCostHist.size() <= nodeBucket)
+        nodeCostHist.resize(nodeBucket + 1, 0);
+    if (timeCostHist.size() <= timeBucket)
+        timeCostHist.resize(timeBucket + 1, 0);
+    nodeCostHist[nodeBucket]++;
+    timeCostHist[timeBucket]++;
 }
 
 
@@ -191,6 +396,178 @@ bool SrcSnkDDA::isInAWrapper(const SVFGNode* src, CallSiteSet& csIdSet)
 }
 
 
+/*!
+ * Forward traversal where an item (n, cxt) adds the whole region of n to the
+ * slice in one step: every node of it is reached from n with the same context,
+ * so only the call and return edges leaving it are processed one by one. Nodes
+ * already processed in cxt are skipped together with their outgoing calls and
+ * returns, which have been followed in cxt before.
+ */
+void SrcSnkDDA::forwardTraverse(DPIm& it)
+{
+    if (!Options::SaberSharedSlice())
+    {
+        CFLSrcSnkSolver::forwardTraverse(it);
+        return;
+    }
+
+    pushIntoWorklist(it);
+    while (!isWorklistEmpty())
+    {
+        DPIm item = popFromWorklist();
+        const SliceRegion& region = getSliceRegion(getNode(item.getCurNodeID()));
+        NodeBS& processed = curState().cxtToProcessedNodes[item.getContexts()];
+        NodeBS newNodes = region.reach;
+        newNodes.intersectWithComplement(processed);
+        numOfRegionVisits++;
+        if (newNodes.empty())
+            continue;
+
+        ProgSlice* slice = getCurSlice();
+        if (!slice->chargeNodes(newNodes.count()))
+        {
+            clearWorklist();
+            return;
+        }
+        numOfRegionNodes += newNodes.count();
+        processed |= newNodes;
+        for (NodeID id : newNodes)
+            addToCurForwardSlice(getNode(id));
+        for (NodeID id : region.sinks)
+        {
+            if (newNodes.test(id))
+            {
+                slice->addToSinks(getNode(id));
+                slice->setPartialReachable();
+            }
+        }
+        for (NodeID id : region.interSrcs)
+        {
+            if (!newNodes.test(id))
+                continue;
+            DPIm srcItem(id, item.getContexts());
+            for (SVFGEdge* edge : getNode(id)->getOutEdges())
+            {
+                if (!isContextPreserving(edge))
+                    FWProcessOutgoingEdge(srcItem, edge);
+            }
+        }
+    }
+}
+
+/*!
+ * Tarjan's algorithm over context-preserving edges, starting from node and
+ * skipping nodes whose SCC is already known. SCCs are completed successors
+ * first, so the regions of all successors exist when an SCC is completed.
+ */
+const SrcSnkDDA::SliceRegion& SrcSnkDDA::getSliceRegion(const SVFGNode* node)
+{
+    std::lock_guard<std::mutex> lock(regionMutex);
+    Map<NodeID, const SliceRegion*>::const_iterator it = nodeToRegion.find(node->getId());
+    if (it != nodeToRegion.end())
+        return *it->second;
+
+    struct Frame
+    {
+        const SVFGNode* node;
+        SVFGNode::const_iterator edgeIt;
+    };
+    Map<NodeID, u32_t> index;
+    Map<NodeID, u32_t> lowLink;
+    std::vector<NodeID> sccStack;
+    NodeBS onStack;
+    std::vector<Frame> callStack;
+    u32_t nextIndex = 0;
+
+    auto visit = [&](const SVFGNode* n)
+    {
+        index[n->getId()] = lowLink[n->getId()] = nextIndex++;
+        sccStack.push_back(n->getId());
+        onStack.set(n->getId());
+        callStack.push_back({n, n->OutEdgeBegin()});
+    };
+
+    visit(node);
+    while (!callStack.empty())
+    {
+        Frame& frame = callStack.back();
+        NodeID id = frame.node->getId();
+        if (frame.edgeIt != frame.node->OutEdgeEnd())
+        {
+            const SVFGEdge* edge = *frame.edgeIt++;
+            const SVFGNode* dst = edge->getDstNode();
+            if (!isContextPreserving(edge) || !mayReachSink(dst) || nodeToRegion.count(dst->getId()))
+                continue;
+            if (index.find(dst->getId()) == index.end())
+                visit(dst);
+            else if (onStack.test(dst->getId()))
+                lowLink[id] = std::min(lowLink[id], index[dst->getId()]);
+            continue;
+        }
+
+        callStack.pop_back();
+        if (!callStack.empty())
+        {
+            NodeID parent = callStack.back().node->getId();
+            lowLink[parent] = std::min(lowLink[parent], lowLink[id]);
+        }
+        if (lowLink[id] == index[id])
+        {
+            std::vector<NodeID> scc;
+            NodeID member;
+            do
+            {
+                member = sccStack.back();
+                sccStack.pop_back();
+                onStack.reset(member);
+                scc.push_back(member);
+            }
+            while (member != id);
+            buildSliceRegion(scc);
+        }
+    }
+    return *nodeToRegion[node->getId()];
+}
+
+void SrcSnkDDA::buildSliceRegion(const std::vector<NodeID>& scc)
+{
+    std::unique_ptr<SliceRegion> region = std::make_unique<SliceRegion>();
+    for (NodeID id : scc)
+        region->reach.set(id);
+
+    Set<const SliceRegion*> succs;
+    for (NodeID id : scc)
+    {
+        const SVFGNode* node = getNode(id);
+        if (isSink(node))
+            region->sinks.set(id);
+        for (const SVFGEdge* edge : node->getOutEdges())
+        {
+            const SVFGNode* dst = edge->getDstNode();
+            if (!mayReachSink(dst))
+                continue;
+            if (!isContextPreserving(edge))
+                region->interSrcs.set(id);
+            else if (!region->reach.test(dst->getId()))
+            {
+                const SliceRegion* succ = nodeToRegion[dst->getId()];
+                assert(succ && "successor SCC not completed?");
+                succs.insert(succ);
+            }
+        }
+    }
+    for (const SliceRegion* succ : succs)
+    {
+        region->reach |= succ->reach;
+        region->sinks |= succ->sinks;
+        region->interSrcs |= succ->interSrcs;
+    }
+
+    for (NodeID id : scc)
+        nodeToRegion[id] = region.get();
+    regions.push_back(std::move(region));
+}
+
 /*!
  * Propagate information forward by matching context
  */
@@ -202,6 +579,10 @@ void SrcSnkDDA::FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge)
     // points-to on the edge indicate whether the object of source node can be propagated
 
     const SVFGNode* dstNode = edge->getDstNode();
+    /// bound the forward slice by nodes which may still reach a sink
+    if (!mayReachSink(dstNode) || getCurSlice()->isBudgetExhausted())
+        return;
+
     DPIm newItem(dstNode->getId(),item.getContexts());
     newItem.setParentNodeID(edge->getSrcID());
 
@@ -244,7 +625,7 @@ void SrcSnkDDA::FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge)
     }
 
     /// whether this dstNode has been visited or not
-    if(forwardVisited(dstNode,newItem))
+    if(forwardVisited(dstNode,newItem) || isRegionProcessed(dstNode,newItem))
     {
         DBOUT(DSaber,outs() << " node "<< dstNode->getId() <<" has been visited\n");
         return;
@@ -264,7 +645,7 @@ void SrcSnkDDA::BWProcessIncomingEdge(const DPIm& item, SVFGEdge* edge)
 {
     DBOUT(DSaber,outs() << "backward propagate from (" << edge->getDstID() << " --> " << edge->getSrcID() << ")\n");
     const SVFGNode* srcNode = edge->getSrcNode();
-    if(backwardVisited(srcNode)) // 共用visitedSet
+    if(getCurSlice()->isBudgetExhausted() || backwardVisited(srcNode)) // 共用visitedSet
         return;
     else
         addBackwardVisited(srcNode);
@@ -278,14 +659,23 @@ void SrcSnkDDA::BWProcessIncomingEdge(const DPIm& item, SVFGEdge* edge)
 /// Set current slice
 void SrcSnkDDA::setCurSlice(const SVFGNode* src)
 {
-    if(_curSlice!=nullptr)
+    SliceState& state = curState();
+    if(state.slice!=nullptr)
     {
-        delete _curSlice;
-        _curSlice = nullptr;
+        delete state.slice;
+        state.slice = nullptr;
         clearVisitedMap();
     }
 
-    _curSlice = new ProgSlice(src,getSaberCondAllocator(), getSVFG());
+    state.slice = createSlice(src);
+}
+
+ProgSlice* SrcSnkDDA::createSlice(const SVFGNode* src)
+{
+    SaberCondAllocator* allocator = curState().allocator ? curState().allocator.get() : getSaberCondAllocator();
+    ProgSlice* slice = new ProgSlice(src, allocator, getSVFG());
+    slice->setBudget(Options::SaberNodeBudget(), Options::SaberGuardBudget(), Options::SaberTimeBudget());
+    return slice;
 }
 
 void SrcSnkDDA::annotateSlice(ProgSlice* slice)
@@ -306,9 +696,68 @@ void SrcSnkDDA::dumpSlices()
         const_cast<SVFG*>(getSVFG())->dump("Slice",true);
 }
 
+void SrcSnkDDA::printSinkReachStat()
+{
+    if (!sinkReachBuilt)
+        return;
+    outs() << "Sink Reach Index Time: " << sinkReachTime / TIMEINTERVAL << "s\n";
+    outs() << "Sink Reach Index Nodes: " << sinkReachableNodes.count() << "/" << getSVFG()->getTotalNodeNum() << "\n";
+    outs() << "Pruned Sources: " << numOfPrunedSources << "/" << getSources().size() << "\n";
+}
+
+void SrcSnkDDA::printBudgetStat()
+{
+    u32_t numOfUnknown[ProgSlice::TimeBudget + 1] = {0};
+    for (const auto& unknown : unknownSources)
+        numOfUnknown[unknown.second]++;
+    outs() << "Unknown Sources: " << unknownSources.size() << "/" << getSources().size()
+           << " (node " << numOfUnknown[ProgSlice::NodeBudget]
+           << ", guard " << numOfUnknown[ProgSlice::GuardBudget]
+           << ", time " << numOfUnknown[ProgSlice::TimeBudget] << ")\n";
+
+    auto printHist = [](const std::string& name, const std::vector<u32_t>& hist)
+    {
+        outs() << name << ":";
+        for (u32_t i = 0; i < hist.size(); ++i)
+        {
+            if (hist[i] == 0)
+                continue;
+            if (i == 0)
+                outs() << " [0]:" << hist[i];
+            else
+                outs() << " [" << (1ULL << (i - 1)) << "," << (1ULL << i) << "):" << hist[i];
+        }
+        outs() << "\n";
+    };
+    printHist("Slice Cost (nodes)", nodeCostHist);
+    printHist("Slice Cost (ms)", timeCostHist);
+}
+
+void SrcSnkDDA::printSharedSliceStat()
+{
+    if (!Options::SaberSharedSlice())
+        return;
+    outs() << "Shared Slice Regions: " << regions.size() << " (" << nodeToRegion.size() << " nodes)\n";
+    outs() << "Shared Slice Visits: " << numOfRegionVisits << " regions, " << numOfRegionNodes << " nodes\n";
+    outs() << "Shared Guard Hits: " << getSaberCondAllocator()->getNumOfVFGuardHits() << "/"
+           << getSaberCondAllocator()->getNumOfVFGuardHits() + getSaberCondAllocator()->getNumOfVFGuards() << "\n";
+}
+
 void SrcSnkDDA::printZ3Stat()
 {
 
     outs() << "Z3 Mem usage: " << getSaberCondAllocator()->getMemUsage() << "\n";
     outs() << "Z3 Number: " << getSaberCondAllocator()->getCondNum() << "\n";
+    const Z3Expr::CacheStat& cache = Z3Expr::getCacheStat();
+    u64_t satMisses = cache.satQueries - cache.satHits;
+    outs() << "Z3 Sat Cache Hits: " << cache.satHits << "/" << cache.satQueries << "\n";
+    outs() << "Z3 Simplify Cache Hits: " << cache.simplifyHits << "/" << cache.simplifyQueries << "\n";
+    outs() << "Z3 Solving Time: " << cache.satTime / TIMEINTERVAL << "s\n";
+    outs() << "Z3 Time Saved (est.): " << (satMisses ? cache.satTime / satMisses * cache.satHits / TIMEINTERVAL : 0) << "s\n";
+    if (SaberCondition::useBDD)
+    {
+        const BDDManager& bdd = BDDManager::getManager();
+        outs() << "BDD Nodes: " << bdd.getNumOfLiveNodes() << "\n";
+        outs() << "BDD GC: " << bdd.getNumOfGC() << "\n";
+    }
 }
@@ -1,6 +1,7 @@
 #include "SABER/TaintChecker.h"
 #include "Graphs/ICFGNode.h"
 #include "Util/SVFUtil.h"
+#include "Graphs/SCC.h"
 #include <cctype>
 #include <chrono>
 
@@ -402,6 +403,143 @@ void TaintChecker::initSinkResourceValVar() {
 
 
 
+/// Call site of an inter-procedural SVFG edge
+static CallSiteID getEdgeCallSiteId(const SVFGEdge* edge)
+{
+    if (const CallDirSVFGEdge* callEdge = SVFUtil::dyn_cast<CallDirSVFGEdge>(edge))
+        return callEdge->getCallSiteId();
+    if (const CallIndSVFGEdge* callEdge = SVFUtil::dyn_cast<CallIndSVFGEdge>(edge))
+        return callEdge->getCallSiteId();
+    if (const RetDirSVFGEdge* retEdge = SVFUtil::dyn_cast<RetDirSVFGEdge>(edge))
+        return retEdge->getCallSiteId();
+    return SVFUtil::cast<RetIndSVFGEdge>(edge)->getCallSiteId();
+}
+
+/*!
+ * Summaries are computed for every node with incoming call edges, callees
+ * before callers. Within a recursive SCC the summaries of its functions are
+ * recomputed until none of them grows.
+ */
+void TaintChecker::buildTaintSummaries()
+{
+    Map<const SVFFunction*, std::vector<const SVFGNode*>> funToEntries;
+    for (const auto& it : *getSVFG())
+    {
+        const SVFGNode* node = it.second;
+        if (node->getFun() == nullptr)
+            continue;
+        for (const SVFGEdge* edge : node->getInEdges())
+        {
+            if (edge->isCallVFGEdge())
+            {
+                funToEntries[node->getFun()].push_back(node);
+                break;
+            }
+        }
+    }
+
+    SCCDetection<PTACallGraph*> callGraphSCC(getCallgraph());
+    callGraphSCC.find();
+    std::vector<NodeID> topoOrder;
+    while (!callGraphSCC.topoNodeStack().empty())
+    {
+        topoOrder.push_back(callGraphSCC.topoNodeStack().top());
+        callGraphSCC.topoNodeStack().pop();
+    }
+
+    /// SCCs are completed, and stacked, callees first
+    for (auto rit = topoOrder.rbegin(); rit != topoOrder.rend(); ++rit)
+    {
+        std::vector<const SVFGNode*> entries;
+        for (NodeID id : callGraphSCC.subNodes(*rit))
+        {
+            auto fit = funToEntries.find(getCallgraph()->getCallGraphNode(id)->getFunction());
+            if (fit != funToEntries.end())
+                entries.insert(entries.end(), fit->second.begin(), fit->second.end());
+        }
+
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (const SVFGNode* entry : entries)
+            {
+                TaintSummary reached;
+                propagateTaint(entry, reached, false);
+                TaintSummary& summary = entryToTaintSummary[entry];
+                if (reached.writeSites.size() != summary.writeSites.size() ||
+                        reached.stores.size() != summary.stores.size() ||
+                        reached.exits.size() != summary.exits.size())
+                {
+                    summary = reached;
+                    changed = callGraphSCC.isInCycle(*rit);
+                }
+            }
+        }
+    }
+}
+
+void TaintChecker::propagateTaint(const SVFGNode* start, TaintSummary& reached, bool unbalanced)
+{
+    Set<const SVFGNode*> visited;
+    FIFOWorkList<const SVFGNode*> worklist;
+    visited.insert(start);
+    worklist.push(start);
+
+    while (!worklist.empty())
+    {
+        const SVFGNode* node = worklist.pop();
+        auto wit = SVFAcutalParamNodeToWriteSiteMap.find(node);
+        if (wit != SVFAcutalParamNodeToWriteSiteMap.end())
+            reached.writeSites.insert(wit->second);
+        if (const StoreSVFGNode* store = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+            reached.stores.insert(store);
+
+        for (const SVFGEdge* edge : node->getOutEdges())
+        {
+            if (edge->isCallVFGEdge())
+            {
+                auto sit = entryToTaintSummary.find(edge->getDstNode());
+                if (sit == entryToTaintSummary.end())
+                    continue;
+                const TaintSummary& summary = sit->second;
+                reached.writeSites.insert(summary.writeSites.begin(), summary.writeSites.end());
+                reached.stores.insert(summary.stores.begin(), summary.stores.end());
+                /// return to this call site only
+                CallSiteID csId = getEdgeCallSiteId(edge);
+                for (const SVFGNode* exit : summary.exits)
+                {
+                    for (const SVFGEdge* retEdge : exit->getOutEdges())
+                    {
+                        if (retEdge->isRetVFGEdge() && getEdgeCallSiteId(retEdge) == csId &&
+                                visited.insert(retEdge->getDstNode()).second)
+                            worklist.push(retEdge->getDstNode());
+                    }
+                }
+            }
+            else if (edge->isRetVFGEdge() && !unbalanced)
+            {
+                reached.exits.insert(node);
+            }
+            else if (visited.insert(edge->getDstNode()).second)
+            {
+                worklist.push(edge->getDstNode());
+            }
+        }
+    }
+}
+
+void TaintChecker::floodWithSummaries(const SVFGNode* src)
+{
+    TaintSummary reached;
+    propagateTaint(src, reached, true);
+    if (curReadSite)
+        srcToSinkMap[curReadSite].insert(reached.writeSites.begin(), reached.writeSites.end());
+    for (const StoreSVFGNode* store : reached.stores)
+        bt(store);
+}
+
+
 void printResourceValVarToYaml(const std::string& valname, const std::string& filename, int line,  const std::string& site, const std::string& maybe_const_memobj = "", bool isglobconst = false) {
     std::ofstream yamlFile("resource_val_var.yaml", std::ios::app);
     if (!yamlFile.is_open()) {
@@ -592,6 +730,13 @@ void TaintChecker::analyze(SVFModule* module)
 
        
         
+        if (Options::TaintSummary()) {
+            buildTaintSummaries();
+            std::chrono::steady_clock::time_point end_summary = std::chrono::steady_clock::now();
+            std::cout << "taint summary time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end_summary - end2).count() << "[ms]" << std::endl;
+            std::cout << "taint summaries: " << entryToTaintSummary.size() << std::endl;
+        }
+
         // flood sources
         for (auto it = ReadSiteToSVFVarDefNodeMap.begin(), eit = ReadSiteToSVFVarDefNodeMap.end(); it != eit; ++it) {
             std::cout << "it->first: " << it->first->toString() << std::endl;
@@ -599,6 +744,10 @@ void TaintChecker::analyze(SVFModule* module)
                 std::cout << "src: " << src->toString() << std::endl;
                 setCurSlice(src);
                 setCurReadSite(it->first);
+                if (Options::TaintSummary()) {
+                    floodWithSummaries(src);
+                    continue;
+                }
                 ContextCond flood_cxt;
                 DPIm item(src->getId(),flood_cxt);
                 forwardTraverse(item);
@@ -0,0 +1,301 @@
+//===- BDDExpr.cpp -- BDD conditions----------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * BDDExpr.cpp
+ */
+
+#include "Util/BDDExpr.h"
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+namespace SVF
+{
+
+BDDManager* BDDManager::mgr = nullptr;
+
+/// Initial sizes, all powers of two
+static constexpr u32_t InitialTableSize = 1 << 16;
+static constexpr u32_t CacheSize = 1 << 18;
+
+/// Get the BDD manager, singleton design here as all conditions must share one unique table
+BDDManager& BDDManager::getManager()
+{
+    if (mgr == nullptr)
+    {
+        mgr = new BDDManager();
+    }
+    return *mgr;
+}
+
+/// Release the manager and all its nodes
+void BDDManager::releaseManager()
+{
+    delete mgr;
+    mgr = nullptr;
+}
+
+BDDManager::BDDManager() : numOfVars(0), gcThreshold(InitialTableSize), numOfGC(0)
+{
+    nodes.push_back({TermVar, FalseNode, FalseNode, 0, NullNode});
+    nodes.push_back({TermVar, TrueNode, TrueNode, 0, NullNode});
+    buckets.assign(InitialTableSize, NullNode);
+    cache.assign(CacheSize, {0, NullNode, NullNode, NullNode});
+}
+
+u32_t BDDManager::newVar()
+{
+    collectIfFull();
+    return getLiteral(numOfVars++, true);
+}
+
+u32_t BDDManager::mk(u32_t var, u32_t low, u32_t high)
+{
+    if (low == high)
+        return low;
+
+    size_t h = hashNode(var, low, high);
+    for (u32_t n = buckets[h]; n != NullNode; n = nodes[n].next)
+    {
+        const Node& node = nodes[n];
+        if (node.var == var && node.low == low && node.high == high)
+            return n;
+    }
+
+    u32_t n;
+    if (freeNodes.empty())
+    {
+        n = nodes.size();
+        nodes.push_back({var, low, high, 0, buckets[h]});
+        if (nodes.size() > 2 * buckets.size())
+        {
+            rehash(buckets.size() * 2);
+            return n;
+        }
+    }
+    else
+    {
+        n = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[n] = {var, low, high, 0, buckets[h]};
+    }
+    buckets[h] = n;
+    return n;
+}
+
+u32_t BDDManager::AND(u32_t lhs, u32_t rhs)
+{
+    assert(lhs != NullNode && rhs != NullNode && "AND on a null condition?");
+    collectIfFull();
+    return apply(AndOp, lhs, rhs);
+}
+
+u32_t BDDManager::OR(u32_t lhs, u32_t rhs)
+{
+    assert(lhs != NullNode && rhs != NullNode && "OR on a null condition?");
+    collectIfFull();
+    return apply(OrOp, lhs, rhs);
+}
+
+u32_t BDDManager::NEG(u32_t node)
+{
+    assert(node != NullNode && "NEG on a null condition?");
+    collectIfFull();
+    return negate(node);
+}
+
+u32_t BDDManager::apply(Op op, u32_t lhs, u32_t rhs)
+{
+    if (op == AndOp)
+    {
+        if (lhs == FalseNode || rhs == FalseNode)
+            return FalseNode;
+        if (lhs == TrueNode || lhs == rhs)
+            return rhs;
+        if (rhs == TrueNode)
+            return lhs;
+    }
+    else
+    {
+        if (lhs == TrueNode || rhs == TrueNode)
+            return TrueNode;
+        if (lhs == FalseNode || lhs == rhs)
+            return rhs;
+        if (rhs == FalseNode)
+            return lhs;
+    }
+    // both operations are commutative
+    if (lhs > rhs)
+        std::swap(lhs, rhs);
+
+    CacheEntry& entry = getCacheEntry(op, lhs, rhs);
+    if (entry.op == op && entry.lhs == lhs && entry.rhs == rhs)
+        return entry.res;
+
+    u32_t lvar = nodes[lhs].var, rvar = nodes[rhs].var;
+    u32_t var = std::min(lvar, rvar);
+    u32_t low = apply(op, lvar == var ? nodes[lhs].low : lhs, rvar == var ? nodes[rhs].low : rhs);
+    u32_t high = apply(op, lvar == var ? nodes[lhs].high : lhs, rvar == var ? nodes[rhs].high : rhs);
+    u32_t res = mk(var, low, high);
+
+    // the entry may have been overwritten by the recursive calls
+    getCacheEntry(op, lhs, rhs) = {op, lhs, rhs, res};
+    return res;
+}
+
+u32_t BDDManager::negate(u32_t node)
+{
+    if (node == FalseNode)
+        return TrueNode;
+    if (node == TrueNode)
+        return FalseNode;
+
+    CacheEntry& entry = getCacheEntry(NegOp, node, node);
+    if (entry.op == NegOp && entry.lhs == node)
+        return entry.res;
+
+    u32_t var = nodes[node].var;
+    u32_t low = negate(nodes[node].low);
+    u32_t high = negate(nodes[node].high);
+    u32_t res = mk(var, low, high);
+
+    getCacheEntry(NegOp, node, node) = {NegOp, node, node, res};
+    return res;
+}
+
+/*!
+ * Mark every node reachable from a referenced one, put the others into the
+ * free list and rebuild the unique table. The computed cache may refer to
+ * reclaimed nodes, so it is cleared as well.
+ */
+void BDDManager::collectGarbage()
+{
+    numOfGC++;
+    std::vector<bool> marked(nodes.size(), false);
+    marked[FalseNode] = marked[TrueNode] = true;
+
+    std::vector<u32_t> worklist;
+    for (u32_t n = TrueNode + 1; n < nodes.size(); ++n)
+    {
+        if (nodes[n].var != FreeVar && nodes[n].ref > 0)
+            worklist.push_back(n);
+    }
+    while (!worklist.empty())
+    {
+        u32_t n = worklist.back();
+        worklist.pop_back();
+        if (marked[n])
+            continue;
+        marked[n] = true;
+        worklist.push_back(nodes[n].low);
+        worklist.push_back(nodes[n].high);
+    }
+
+    freeNodes.clear();
+    for (u32_t n = TrueNode + 1; n < nodes.size(); ++n)
+    {
+        if (!marked[n])
+        {
+            nodes[n].var = FreeVar;
+            freeNodes.push_back(n);
+        }
+    }
+    // reuse low indices first
+    std::reverse(freeNodes.begin(), freeNodes.end());
+
+    rehash(buckets.size());
+    for (CacheEntry& entry : cache)
+        entry = {0, NullNode, NullNode, NullNode};
+
+    // grow the table if most of it is still alive
+    if (getNumOfLiveNodes() * 2 > gcThreshold)
+        gcThreshold *= 2;
+}
+
+void BDDManager::rehash(size_t size)
+{
+    buckets.assign(size, NullNode);
+    for (u32_t n = TrueNode + 1; n < nodes.size(); ++n)
+    {
+        Node& node = nodes[n];
+        if (node.var == FreeVar)
+            continue;
+        size_t h = hashNode(node.var, node.low, node.high);
+        node.next = buckets[h];
+        buckets[h] = n;
+    }
+}
+
+void BDDManager::support(u32_t node, NodeBS& vars) const
+{
+    Set<u32_t> visited;
+    std::vector<u32_t> worklist;
+    worklist.push_back(node);
+    while (!worklist.empty())
+    {
+        u32_t n = worklist.back();
+        worklist.pop_back();
+        if (n == FalseNode || n == TrueNode || n == NullNode || !visited.insert(n).second)
+            continue;
+        vars.set(nodes[n].var);
+        worklist.push_back(nodes[n].low);
+        worklist.push_back(nodes[n].high);
+    }
+}
+
+std::string BDDManager::dumpStr(u32_t node) const
+{
+    if (node == NullNode)
+        return "null";
+    if (node == TrueNode)
+        return "true";
+    if (node == FalseNode)
+        return "false";
+
+    std::ostringstream out;
+    std::vector<std::string> literals;
+    bool first = true;
+    std::function<void(u32_t)> dumpPaths = [&](u32_t n)
+    {
+        if (n == FalseNode)
+            return;
+        if (n == TrueNode)
+        {
+            out << (first ? "" : " | ") << "(";
+            for (u32_t i = 0; i < literals.size(); ++i)
+                out << (i ? " & " : "") << literals[i];
+            out << ")";
+            first = false;
+            return;
+        }
+        std::string var = "c" + std::to_string(nodes[n].var);
+        literals.push_back("!" + var);
+        dumpPaths(nodes[n].low);
+        literals.back() = var;
+        dumpPaths(nodes[n].high);
+        literals.pop_back();
+    };
+    dumpPaths(node);
+    return out.str();
+}
+
+} // End namespace SVF
@@ -56,12 +56,42 @@ const Option<u32_t> Options::FsTimeLimit(
     0
 );
 
+const Option<u32_t> Options::PtsGcInterval(
+    "pts-gc-interval",
+    "number of SVFG nodes processed by flow-sensitive analyses between sweeps of unused persistent points-to sets (0 to never sweep)",
+    0
+);
+
+const Option<std::string> Options::FsCheckpoint(
+    "fs-checkpoint",
+    "file to periodically write the solver state of flow-sensitive analyses to",
+    ""
+);
+
+const Option<u32_t> Options::FsCheckpointInterval(
+    "fs-checkpoint-interval",
+    "seconds between checkpoints of flow-sensitive analyses (see -fs-checkpoint)",
+    600
+);
+
+const Option<std::string> Options::FsResume(
+    "fs-resume",
+    "checkpoint file (see -fs-checkpoint) to resume flow-sensitive solving from",
+    ""
+);
+
 const Option<u32_t> Options::VersioningThreads(
     "versioning-threads",
     "number of threads to use in the versioning phase of versioned flow-sensitive analysis",
     1
 );
 
+const Option<u32_t> Options::VersionPropThreads(
+    "version-prop-threads",
+    "number of threads to use in the version propagation phase of versioned flow-sensitive analysis",
+    1
+);
+
 const Option<u32_t> Options::AnderTimeLimit(
     "ander-time-limit",
     "time limit for Andersen's analyses (ignored when -fs-time-limit set)",
@@ -100,6 +130,42 @@ const Option<std::string> Options::UserInputQuery(
     "all"
 );
 
+const Option<u32_t> Options::DDAThreads(
+    "dda-threads",
+    "Number of demand-driven solvers answering queries in parallel, each with its own SVFG",
+    1
+);
+
+const Option<std::string> Options::DDAQueryCache(
+    "dda-query-cache",
+    "Reuse DDA query results of previous runs from the given file and write this run's results back to it",
+    ""
+);
+
+const Option<bool> Options::DDAAdaptive(
+    "dda-adaptive",
+    "Order ContextDDA queries by estimated cost and spend context budget only where the flow-sensitive answer may be refined",
+    false
+);
+
+const Option<std::string> Options::DDAQueryProfile(
+    "dda-query-profile",
+    "Write the per-query cost profile of -dda-adaptive to the given CSV file",
+    ""
+);
+
+const Option<bool> Options::DDASummary(
+    "dda-summary",
+    "Reuse function summaries from formal-outs to their reaching definitions across DDA queries and contexts",
+    true
+);
+
+const Option<std::string> Options::DDAServer(
+    "dda-server",
+    "Keep the analysis alive and answer pts/alias/callees requests from stdin (\"-\") or the Unix-domain socket at the given path",
+    ""
+);
+
 
 
 const Option<bool> Options::InsenRecur(
@@ -191,6 +257,12 @@ const Option<std::string> Options::SelfCycle(
     ""
 );
 
+const Option<u32_t> Options::SVFGOptThreads(
+    "svfg-opt-threads",
+    "Number of threads used to retarget actual-in/formal-out edges in SVFG optimisation",
+    1
+);
+
 
 
 
@@ -423,6 +495,12 @@ const OptionMap<MemSSA::MemPartition> Options::MemPar(
 }
 );
 
+const Option<u32_t> Options::MSSAThreads(
+    "mssa-threads",
+    "number of threads to partition memory regions and build memory SSA with (functions are handled in parallel)",
+    1
+);
+
 
 // SVFG builder (SVFGBuilder.cpp)
 const Option<bool> Options::SVFGWithIndirectCall(
@@ -449,12 +527,24 @@ const Option<std::string> Options::ReadSVFG(
     ""
 );
 
+const Option<bool> Options::WriteSVFGBinary(
+    "write-svfg-binary",
+    "Write SVFG as a binary snapshot instead of the text format",
+    false
+);
+
 const Option<std::string> Options::ReadTaintConfig(
     "read-taint-config",
     "Read taint config from a file",
     ""
 );
 
+const Option<bool> Options::TaintSummary(
+    "taint-summary",
+    "Flood taint sources with function-level taint summaries instead of re-walking callees",
+    true
+);
+
 
 const Option<bool> Options::IntraLock(
     "intra-lock-td-edge",
@@ -522,6 +612,42 @@ const Option<u32_t> Options::CxtLimit(
     3
 );
 
+const Option<u32_t> Options::SaberThreads(
+    "saber-threads",
+    "Number of threads slicing sources in parallel for source-sink analysis",
+    1
+);
+
+const Option<bool> Options::SaberSinkReach(
+    "saber-sink-reach",
+    "Skip sources reaching no sink and bound forward slices by a precomputed sink reachability index",
+    true
+);
+
+const Option<u32_t> Options::SaberNodeBudget(
+    "saber-node-budget",
+    "Maximum SVFG nodes visited per source before it is reported as unknown (0: unlimited)",
+    0
+);
+
+const Option<u32_t> Options::SaberGuardBudget(
+    "saber-guard-budget",
+    "Maximum value-flow guards computed per source before it is reported as unknown (0: unlimited)",
+    0
+);
+
+const Option<u32_t> Options::SaberTimeBudget(
+    "saber-time-budget",
+    "Maximum wall-clock seconds per source before it is reported as unknown (0: unlimited)",
+    0
+);
+
+const Option<bool> Options::SaberSharedSlice(
+    "saber-shared-slice",
+    "Share forward reachable regions of the SVFG and value-flow guards among the slices of all sources",
+    true
+);
+
 
 // CHG.cpp
 const Option<bool> Options::DumpCHA(
@@ -583,6 +709,12 @@ const Option<u32_t> Options::MaxZ3Size(
     30
 );
 
+const Option<u32_t> Options::Z3CacheSize(
+    "z3-cache-size",
+    "Maximum number of memoised satisfiability results and simplified forms of Z3 expressions (0 to disable)",
+    100000
+);
+
 // BoundedZ3Expr.cpp
 const Option<u32_t> Options::MaxBVLen(
     "max-bv-len",
@@ -599,6 +731,12 @@ const Option<bool> Options::PrintPathCond(
     false
 );
 
+const Option<bool> Options::SaberBDD(
+    "saber-bdd",
+    "Represent path conditions of source-sink analysis as BDDs instead of Z3 expressions",
+    false
+);
+
 
 // SaberSVFGBuilder.cpp
 const Option<bool> Options::CollectExtRetGlobals(
@@ -805,6 +943,10 @@ const Option<u32_t> Options::Timeout(
     "timeout", "time out (seconds), set -1 (no timeout), default 14400s",14400);
 const Option<std::string> Options::OutputName(
     "output","output db file","output.db");
+const Option<std::string> Options::BugJson(
+    "bug-json","Stream confirmed bugs to this JSON file","");
+const Option<std::string> Options::BugSarif(
+    "bug-sarif","Stream confirmed bugs to this SARIF 2.1.0 file","");
 const Option<bool> Options::BufferOverflowCheck(
     "overflow","Buffer Overflow Detection",false);
 const Option<bool> Options::MemoryLeakCheck(
@@ -821,6 +963,14 @@ const Option<bool> Options::GepUnknownIdx(
     "gep-unknown-idx","Skip Gep Unknown Index",false);
 const Option<bool> Options::RunUncallFuncs(
     "run-uncall-fun","Skip Gep Unknown Index",false);
+const Option<u32_t> Options::AEThreads(
+    "ae-threads","Number of threads analysing entry functions in parallel",1);
+const Option<u32_t> Options::AESummaryLimit(
+    "ae-summary-limit","Maximum number of summaries kept for a function, 0 (default) disables function summaries",0);
+const Option<bool> Options::AEReuseEvals(
+    "ae-reuse-evals","Reuse the last evaluation of an ICFG node if the values it uses did not change (states still propagate densely in WTO order)",false);
+const Option<bool> Options::AEEvictStates(
+    "ae-evict-states","Drop the abstract state of an ICFG node once no later node of its function reads it, in functions analysed only once",false);
 const Option<bool> Options::ICFGMergeAdjacentNodes(
     "icfg-merge-adjnodes","ICFG Simplification - Merge Adjacent Nodes in the Same Basic Block.",false);
 
@@ -29,6 +29,7 @@
 #include <cassert>
 #include "Util/cJSON.h"
 #include "Util/SVFUtil.h"
+#include "Util/Options.h"
 #include <sstream>
 #include <fstream>
 
@@ -336,9 +337,9 @@ SVFBugReport::~SVFBugReport()
     }
 }
 
-void SVFBugReport::dumpToJsonFile(const std::string& filePath) const
+cJSON* SVFBugReport::bugToJson(const GenericBug* bugPtr)
 {
-    std::map<u32_t, std::string> eventType2Str =
+    static const std::map<u32_t, std::string> eventType2Str =
     {
         {SVFBugEvent::CallSite, "call site"},
         {SVFBugEvent::Caller, "caller"},
@@ -346,85 +347,182 @@ void SVFBugReport::dumpToJsonFile(const std::string& filePath) const
         {SVFBugEvent::Branch, "branch"}
     };
 
-    ofstream jsonFile(filePath, ios::out);
+    cJSON *singleDefect = cJSON_CreateObject();
 
-    jsonFile << "{\n";
+    /// Add bug information to JSON
+    cJSON *bugType = cJSON_CreateString(
+                         GenericBug::BugType2Str.at(bugPtr->getBugType()).c_str());
+    cJSON_AddItemToObject(singleDefect, "DefectType", bugType);
 
-    /// Add defects
-    jsonFile << "\"Defects\": [\n";
-    size_t commaCounter = bugSet.size() - 1;
-    for (auto bugPtr : bugSet)
+    cJSON *bugLoc = cJSON_Parse(bugPtr->getLoc().c_str());
+    if (bugLoc == nullptr)
     {
-        cJSON *singleDefect = cJSON_CreateObject();
+        bugLoc = cJSON_CreateObject();
+    }
+    cJSON_AddItemToObject(singleDefect, "Location", bugLoc);
 
-        /// Add bug information to JSON
-        cJSON *bugType = cJSON_CreateString(
-                             GenericBug::BugType2Str.at(bugPtr->getBugType()).c_str());
-        cJSON_AddItemToObject(singleDefect, "DefectType", bugType);
+    cJSON *bugFunction = cJSON_CreateString(
+                             bugPtr->getFuncName().c_str());
+    cJSON_AddItemToObject(singleDefect, "Function", bugFunction);
 
-        cJSON *bugLoc = cJSON_Parse(bugPtr->getLoc().c_str());
-        if (bugLoc == nullptr)
+    cJSON_AddItemToObject(singleDefect, "Description",
+                          bugPtr->getBugDescription());
+
+    /// Add event information to JSON
+    cJSON *eventList = cJSON_CreateArray();
+    const GenericBug::EventStack &bugEventStack = bugPtr->getEventStack();
+    if (BufferOverflowBug::classof(bugPtr))
+    {
+        // Add only when bug is context sensitive
+        for (const SVFBugEvent &event : bugEventStack)
         {
-            bugLoc = cJSON_CreateObject();
-        }
-        cJSON_AddItemToObject(singleDefect, "Location", bugLoc);
+            if (event.getEventType() == SVFBugEvent::SourceInst)
+            {
+                continue;
+            }
+
+            cJSON *singleEvent = cJSON_CreateObject();
+            // Event type
+            auto typeIt = eventType2Str.find(event.getEventType());
+            cJSON *eventType = cJSON_CreateString(
+                                   typeIt == eventType2Str.end() ? "" : typeIt->second.c_str());
+            cJSON_AddItemToObject(singleEvent, "EventType", eventType);
+            // Function name
+            cJSON *eventFunc = cJSON_CreateString(
+                                   event.getFuncName().c_str());
+            cJSON_AddItemToObject(singleEvent, "Function", eventFunc);
+            // Event loc
+            cJSON *eventLoc = cJSON_Parse(event.getEventLoc().c_str());
+            if (eventLoc == nullptr)
+            {
+                eventLoc = cJSON_CreateObject();
+            }
+            cJSON_AddItemToObject(singleEvent, "Location", eventLoc);
+            // Event description
+            cJSON *eventDescription = cJSON_CreateString(
+                                          event.getEventDescription().c_str());
+            cJSON_AddItemToObject(singleEvent, "Description", eventDescription);
 
-        cJSON *bugFunction = cJSON_CreateString(
-                                 bugPtr->getFuncName().c_str());
-        cJSON_AddItemToObject(singleDefect, "Function", bugFunction);
+            cJSON_AddItemToArray(eventList, singleEvent);
+        }
+    }
+    cJSON_AddItemToObject(singleDefect, "Events", eventList);
 
-        cJSON_AddItemToObject(singleDefect, "Description",
-                              bugPtr->getBugDescription());
+    return singleDefect;
+}
 
-        /// Add event information to JSON
-        cJSON *eventList = cJSON_CreateArray();
-        const GenericBug::EventStack &bugEventStack = bugPtr->getEventStack();
-        if (BufferOverflowBug::classof(bugPtr))
+/*!
+ * SARIF location of an event location, e.g., { "ln": 12, "cl": 5, "fl": "a.c" }
+ */
+static cJSON* locToSarif(const std::string& loc, const std::string& message)
+{
+    cJSON *location = cJSON_CreateObject();
+    cJSON *physicalLocation = cJSON_CreateObject();
+    cJSON *parsedLoc = cJSON_Parse(loc.c_str());
+    if (parsedLoc != nullptr)
+    {
+        cJSON *file = cJSON_GetObjectItem(parsedLoc, "fl");
+        cJSON *line = cJSON_GetObjectItem(parsedLoc, "ln");
+        cJSON *column = cJSON_GetObjectItem(parsedLoc, "cl");
+        if (cJSON_IsString(file))
         {
-            // Add only when bug is context sensitive
-            for (const SVFBugEvent &event : bugEventStack)
-            {
-                if (event.getEventType() == SVFBugEvent::SourceInst)
-                {
-                    continue;
-                }
-
-                cJSON *singleEvent = cJSON_CreateObject();
-                // Event type
-                cJSON *eventType = cJSON_CreateString(
-                                       eventType2Str[event.getEventType()].c_str());
-                cJSON_AddItemToObject(singleEvent, "EventType", eventType);
-                // Function name
-                cJSON *eventFunc = cJSON_CreateString(
-                                       event.getFuncName().c_str());
-                cJSON_AddItemToObject(singleEvent, "Function", eventFunc);
-                // Event loc
-                cJSON *eventLoc = cJSON_Parse(event.getEventLoc().c_str());
-                if (eventLoc == nullptr)
-                {
-                    eventLoc = cJSON_CreateObject();
-                }
-                cJSON_AddItemToObject(singleEvent, "Location", eventLoc);
-                // Event description
-                cJSON *eventDescription = cJSON_CreateString(
-                                              event.getEventDescription().c_str());
-                cJSON_AddItemToObject(singleEvent, "Description", eventDescription);
-
-                cJSON_AddItemToArray(eventList, singleEvent);
-            }
+            cJSON *artifactLocation = cJSON_CreateObject();
+            cJSON_AddStringToObject(artifactLocation, "uri", file->valuestring);
+            cJSON_AddItemToObject(physicalLocation, "artifactLocation", artifactLocation);
+        }
+        // SARIF lines and columns start from 1
+        if (cJSON_IsNumber(line) && line->valueint > 0)
+        {
+            cJSON *region = cJSON_CreateObject();
+            cJSON_AddNumberToObject(region, "startLine", line->valueint);
+            if (cJSON_IsNumber(column) && column->valueint > 0)
+                cJSON_AddNumberToObject(region, "startColumn", column->valueint);
+            cJSON_AddItemToObject(physicalLocation, "region", region);
         }
-        cJSON_AddItemToObject(singleDefect, "Events", eventList);
+        cJSON_Delete(parsedLoc);
+    }
+    cJSON_AddItemToObject(location, "physicalLocation", physicalLocation);
+    if (!message.empty())
+    {
+        cJSON *msg = cJSON_CreateObject();
+        cJSON_AddStringToObject(msg, "text", message.c_str());
+        cJSON_AddItemToObject(location, "message", msg);
+    }
+    return location;
+}
+
+cJSON* SVFBugReport::bugToSarif(const GenericBug* bug)
+{
+    const std::string& bugType = GenericBug::BugType2Str.at(bug->getBugType());
+    bool partial = bug->getBugType() == GenericBug::PARTIALBUFOVERFLOW ||
+                   bug->getBugType() == GenericBug::PARTIALLEAK ||
+                   bug->getBugType() == GenericBug::FILEPARTIALCLOSE ||
+                   bug->getBugType() == GenericBug::PARTIALNULLPTRDEREFERENCE;
+
+    cJSON *result = cJSON_CreateObject();
+    cJSON_AddStringToObject(result, "ruleId", bugType.c_str());
+    cJSON_AddStringToObject(result, "level", partial ? "warning" : "error");
+
+    cJSON *message = cJSON_CreateObject();
+    std::string text = bugType + " in function " + bug->getFuncName();
+    cJSON_AddStringToObject(message, "text", text.c_str());
+    cJSON_AddItemToObject(result, "message", message);
+
+    cJSON *locations = cJSON_CreateArray();
+    cJSON_AddItemToArray(locations, locToSarif(bug->getLoc(), ""));
+    cJSON_AddItemToObject(result, "locations", locations);
+
+    /// the other events, e.g., branches of a partial leak, are related locations
+    const GenericBug::EventStack& eventStack = bug->getEventStack();
+    if (eventStack.size() > 1)
+    {
+        cJSON *related = cJSON_CreateArray();
+        for (auto eventIt = eventStack.begin(); eventIt != eventStack.end() - 1; ++eventIt)
+            cJSON_AddItemToArray(related, locToSarif(eventIt->getEventLoc(), eventIt->getEventDescription()));
+        cJSON_AddItemToObject(result, "relatedLocations", related);
+    }
+    return result;
+}
+
+/// SARIF header up to the opening of the results array
+static void writeSarifHeader(std::ostream& out)
+{
+    out << "{\n\"$schema\": \"https://json.schemastore.org/sarif-2.1.0.json\",\n"
+        << "\"version\": \"2.1.0\",\n"
+        << "\"runs\": [{\n"
+        << "\"tool\": {\"driver\": {\"name\": \"SVF\", \"informationUri\": \"https://github.com/SVF-tools/SVF\"}},\n"
+        << "\"results\": [\n";
+}
+
+static void writeSarifTrailer(std::ostream& out)
+{
+    out << "\n]\n}]\n}\n";
+}
+
+void SVFBugReport::dumpToJsonFile(const std::string& filePath) const
+{
+    ofstream jsonFile(filePath, ios::out);
+
+    jsonFile << "{\n";
+
+    /// Add defects
+    jsonFile << "\"Defects\": [\n";
+    bool first = true;
+    for (auto bugPtr : bugSet)
+    {
+        cJSON *singleDefect = bugToJson(bugPtr);
 
         /// Dump single bug to JSON string and write to file
         char *singleDefectStr = cJSON_Print(singleDefect);
-        jsonFile << singleDefectStr;
-        if (commaCounter != 0)
+        if (!first)
         {
             jsonFile << ",\n";
         }
-        commaCounter--;
+        first = false;
+        jsonFile << singleDefectStr;
 
         /// Destroy the cJSON object
+        cJSON_free(singleDefectStr);
         cJSON_Delete(singleDefect);
     }
     jsonFile << "\n],\n";
@@ -437,3 +535,153 @@ void SVFBugReport::dumpToJsonFile(const std::string& filePath) const
     jsonFile << "}";
     jsonFile.close();
 }
+
+void SVFBugReport::dumpToSarifFile(const std::string& filePath) const
+{
+    ofstream sarifFile(filePath, ios::out);
+    writeSarifHeader(sarifFile);
+    bool first = true;
+    for (auto bugPtr : bugSet)
+    {
+        cJSON *result = bugToSarif(bugPtr);
+        char *resultStr = cJSON_PrintUnformatted(result);
+        if (!first)
+            sarifFile << ",\n";
+        first = false;
+        sarifFile << resultStr;
+        cJSON_free(resultStr);
+        cJSON_Delete(result);
+    }
+    writeSarifTrailer(sarifFile);
+    sarifFile.close();
+}
+
+SVFBugStream* SVFBugStream::getBugStream()
+{
+    // created on first use, completed by its destructor at exit
+    static SVFBugStream stream(Options::BugJson(), Options::BugSarif());
+    return stream.jsonFile.is_open() || stream.sarifFile.is_open() ? &stream : nullptr;
+}
+
+SVFBugStream::SVFBugStream(const std::string& jsonPath, const std::string& sarifPath) :
+    time(0), mem(""), coverage(0), numOfWrittenBugs(0), numOfDuplicateBugs(0), closed(false)
+{
+    if (!jsonPath.empty())
+    {
+        jsonBuffer.resize(BufferSize);
+        jsonFile.rdbuf()->pubsetbuf(jsonBuffer.data(), jsonBuffer.size());
+        jsonFile.open(jsonPath, ios::out);
+        if (!jsonFile.is_open())
+            SVFUtil::errs() << SVFUtil::errMsg("cannot open bug report file ") << jsonPath << "\n";
+        else
+            jsonFile << "{\n\"Defects\": [\n";
+    }
+    if (!sarifPath.empty())
+    {
+        sarifBuffer.resize(BufferSize);
+        sarifFile.rdbuf()->pubsetbuf(sarifBuffer.data(), sarifBuffer.size());
+        sarifFile.open(sarifPath, ios::out);
+        if (!sarifFile.is_open())
+            SVFUtil::errs() << SVFUtil::errMsg("cannot open bug report file ") << sarifPath << "\n";
+        else
+            writeSarifHeader(sarifFile);
+    }
+}
+
+SVFBugStream::~SVFBugStream()
+{
+    close();
+}
+
+/*!
+ * FNV-1a over the bug type, its function and the locations and descriptions
+ * of its events. The same bug found from another source or context hashes
+ * the same.
+ */
+u64_t SVFBugStream::hashBug(const GenericBug* bug)
+{
+    u64_t h = 14695981039346656037ULL;
+    auto mix = [&h](const std::string& str)
+    {
+        for (unsigned char c : str)
+        {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        // separator, so that "ab"+"c" differs from "a"+"bc"
+        h ^= 0xff;
+        h *= 1099511628211ULL;
+    };
+    mix(std::to_string(bug->getBugType()));
+    mix(bug->getFuncName());
+    for (const SVFBugEvent& event : bug->getEventStack())
+    {
+        mix(event.getEventLoc());
+        mix(event.getEventDescription());
+    }
+    return h;
+}
+
+bool SVFBugStream::writeBug(const GenericBug* bug)
+{
+    u64_t h = hashBug(bug);
+    std::lock_guard<std::mutex> lock(streamMutex);
+    if (closed || !writtenBugs.insert(h).second)
+    {
+        numOfDuplicateBugs++;
+        return false;
+    }
+
+    if (jsonFile.is_open())
+    {
+        cJSON *defect = SVFBugReport::bugToJson(bug);
+        char *defectStr = cJSON_Print(defect);
+        if (numOfWrittenBugs != 0)
+            jsonFile << ",\n";
+        jsonFile << defectStr;
+        cJSON_free(defectStr);
+        cJSON_Delete(defect);
+    }
+    if (sarifFile.is_open())
+    {
+        cJSON *result = SVFBugReport::bugToSarif(bug);
+        char *resultStr = cJSON_PrintUnformatted(result);
+        if (numOfWrittenBugs != 0)
+            sarifFile << ",\n";
+        sarifFile << resultStr;
+        cJSON_free(resultStr);
+        cJSON_Delete(result);
+    }
+    numOfWrittenBugs++;
+    return true;
+}
+
+void SVFBugStream::setStat(double t, const std::string& m, double c)
+{
+    std::lock_guard<std::mutex> lock(streamMutex);
+    time = t;
+    mem = m;
+    coverage = c;
+}
+
+void SVFBugStream::close()
+{
+    std::lock_guard<std::mutex> lock(streamMutex);
+    if (closed)
+        return;
+    closed = true;
+    if (jsonFile.is_open())
+    {
+        jsonFile << "\n],\n";
+        jsonFile << "\"Time\": " << time << ",\n";
+        jsonFile << "\"Memory\": \"" << mem << "\",\n";
+        jsonFile << "\"Coverage\": " << coverage << "\n";
+        jsonFile << "}";
+        jsonFile.close();
+    }
+    if (sarifFile.is_open())
+    {
+        writeSarifTrailer(sarifFile);
+        sarifFile.close();
+    }
+}
@@ -28,17 +28,123 @@
 
 #include "Util/Z3Expr.h"
 #include "Util/Options.h"
+#include "Util/SVFStat.h"
+#include <list>
 
 namespace SVF
 {
 
+/*!
+ * Least recently used map from expressions to results. The cache holds a
+ * reference to each key, so z3 cannot recycle the id of a cached expression.
+ */
+template<typename Value>
+class Z3ExprLRUCache
+{
+public:
+    /// Result of an expression, nullptr if it is not cached
+    Value* find(const z3::expr& e)
+    {
+        typename IdToEntryMap::iterator it = idToEntry.find(e.id());
+        if (it == idToEntry.end())
+            return nullptr;
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    void insert(const z3::expr& e, const Value& v)
+    {
+        if (Options::Z3CacheSize() == 0)
+            return;
+        entries.emplace_front(e, v);
+        idToEntry[e.id()] = entries.begin();
+        while (entries.size() > Options::Z3CacheSize())
+        {
+            idToEntry.erase(entries.back().first.id());
+            entries.pop_back();
+        }
+    }
+
+private:
+    typedef std::list<std::pair<z3::expr, Value>> EntryList;
+    typedef Map<u32_t, typename EntryList::iterator> IdToEntryMap;
+    EntryList entries;			///< most recently used first
+    IdToEntryMap idToEntry;
+};
+
 z3::context *Z3Expr::ctx = nullptr;
 z3::solver* Z3Expr::solver = nullptr;
+Z3Expr::CacheStat Z3Expr::cacheStat;
+
+/// Created on demand and released with the context, as their keys live in it
+static Z3ExprLRUCache<bool>* satCache = nullptr;
+static Z3ExprLRUCache<z3::expr>* simplifyCache = nullptr;
+
+/*!
+ * Context of a thread with its solver, caches and statistics. Members are
+ * destroyed in reverse order, so the context outlives every expression here.
+ */
+struct Z3ThreadContext
+{
+    z3::context ctx;
+    z3::solver solver;
+    Z3ExprLRUCache<bool> satCache;
+    Z3ExprLRUCache<z3::expr> simplifyCache;
+    Z3Expr::CacheStat cacheStat;
+    bool enabled = true;
+
+    Z3ThreadContext() : solver(ctx) {}
+};
+static thread_local Z3ThreadContext* threadContext = nullptr;
+
+/// Context of the calling thread if enabled, nullptr if the shared context is used
+static inline Z3ThreadContext* getEnabledThreadContext()
+{
+    return threadContext && threadContext->enabled ? threadContext : nullptr;
+}
+
+/// give the calling thread its own context, enabled
+void Z3Expr::newThreadContext()
+{
+    assert(threadContext == nullptr && "thread already has a context");
+    threadContext = new Z3ThreadContext();
+}
+
+/// release the context of the calling thread and add its statistics to the shared ones
+void Z3Expr::releaseThreadContext()
+{
+    assert(threadContext && "thread has no context");
+    const CacheStat& stat = threadContext->cacheStat;
+    cacheStat.satQueries += stat.satQueries;
+    cacheStat.satHits += stat.satHits;
+    cacheStat.simplifyQueries += stat.simplifyQueries;
+    cacheStat.simplifyHits += stat.simplifyHits;
+    cacheStat.satTime += stat.satTime;
+    delete threadContext;
+    threadContext = nullptr;
+}
+
+/// switch the calling thread between its own context and the shared one
+void Z3Expr::enableThreadContext(bool enable)
+{
+    assert(threadContext && "thread has no context");
+    threadContext->enabled = enable;
+}
+
+/// an expression of another context translated into the current one
+z3::expr Z3Expr::translate(const z3::expr& e)
+{
+    z3::context& dst = getContext();
+    if (&e.ctx() == &dst)
+        return e;
+    return z3::to_expr(dst, Z3_translate(e.ctx(), e, dst));
+}
 
 
 /// release z3 context
 void Z3Expr::releaseContext()
 {
+    clearCache();
     if(solver)
         releaseSolver();
     delete ctx;
@@ -55,6 +161,8 @@ void Z3Expr::releaseSolver()
 /// Get z3 solver, singleton design here to make sure we only have one context
 z3::solver &Z3Expr::getSolver()
 {
+    if (Z3ThreadContext* thread = getEnabledThreadContext())
+        return thread->solver;
     if (solver == nullptr)
     {
         solver = new z3::solver(getContext());
@@ -65,6 +173,8 @@ z3::solver &Z3Expr::getSolver()
 /// Get z3 context, singleton design here to make sure we only have one context
 z3::context &Z3Expr::getContext()
 {
+    if (Z3ThreadContext* thread = getEnabledThreadContext())
+        return thread->ctx;
     if (ctx == nullptr)
     {
         ctx = new z3::context();
@@ -72,6 +182,61 @@ z3::context &Z3Expr::getContext()
     return *ctx;
 }
 
+/// whether an expression is satisfiable (sat or unknown) in a fresh scope of the solver
+bool Z3Expr::isSatisfiable(const Z3Expr &z3Expr)
+{
+    Z3ThreadContext* thread = getEnabledThreadContext();
+    CacheStat& stat = thread ? thread->cacheStat : cacheStat;
+    stat.satQueries++;
+    if (thread == nullptr && satCache == nullptr)
+        satCache = new Z3ExprLRUCache<bool>();
+    Z3ExprLRUCache<bool>& cache = thread ? thread->satCache : *satCache;
+    if (bool* sat = cache.find(z3Expr.getExpr()))
+    {
+        stat.satHits++;
+        return *sat;
+    }
+
+    double start = SVFStat::getClk(true);
+    getSolver().push();
+    getSolver().add(z3Expr.getExpr());
+    z3::check_result res = getSolver().check();
+    getSolver().pop();
+    stat.satTime += SVFStat::getClk(true) - start;
+
+    bool sat = res != z3::unsat;
+    cache.insert(z3Expr.getExpr(), sat);
+    return sat;
+}
+
+/// simplified form of an expression
+Z3Expr Z3Expr::getSimplified(const Z3Expr &z3Expr)
+{
+    Z3ThreadContext* thread = getEnabledThreadContext();
+    CacheStat& stat = thread ? thread->cacheStat : cacheStat;
+    stat.simplifyQueries++;
+    if (thread == nullptr && simplifyCache == nullptr)
+        simplifyCache = new Z3ExprLRUCache<z3::expr>();
+    Z3ExprLRUCache<z3::expr>& cache = thread ? thread->simplifyCache : *simplifyCache;
+    if (z3::expr* simplified = cache.find(z3Expr.getExpr()))
+    {
+        stat.simplifyHits++;
+        return *simplified;
+    }
+    z3::expr simplified = z3Expr.getExpr().simplify();
+    cache.insert(z3Expr.getExpr(), simplified);
+    return simplified;
+}
+
+/// drop all memoised results
+void Z3Expr::clearCache()
+{
+    delete satCache;
+    satCache = nullptr;
+    delete simplifyCache;
+    simplifyCache = nullptr;
+}
+
 /// get the number of subexpression of a Z3 expression
 u32_t Z3Expr::getExprSize(const Z3Expr &z3Expr)
 {
@@ -105,15 +270,11 @@ Z3Expr Z3Expr::AND(const Z3Expr &lhs, const Z3Expr &rhs)
     }
     else
     {
-        Z3Expr expr = (lhs && rhs).simplify();
+        Z3Expr expr = getSimplified(lhs && rhs);
         // check subexpression size and option limit
         if (Z3Expr::getExprSize(expr) > Options::MaxZ3Size())
         {
-            getSolver().push();
-            getSolver().add(expr.getExpr());
-            z3::check_result res = getSolver().check();
-            getSolver().pop();
-            if (res != z3::unsat)
+            if (isSatisfiable(expr))
             {
                 return lhs;
             }
@@ -143,15 +304,11 @@ Z3Expr Z3Expr::OR(const Z3Expr &lhs, const Z3Expr &rhs)
     }
     else
     {
-        Z3Expr expr = (lhs || rhs).simplify();
+        Z3Expr expr = getSimplified(lhs || rhs);
         // check subexpression size and option limit
         if (Z3Expr::getExprSize(expr) > Options::MaxZ3Size())
         {
-            getSolver().push();
-            getSolver().add(expr.getExpr());
-            z3::check_result res = getSolver().check();
-            getSolver().pop();
-            if (res != z3::unsat)
+            if (isSatisfiable(expr))
             {
                 return Z3Expr::getTrueCond();
             }
@@ -79,9 +79,13 @@ void FlowSensitive::solveConstraints()
     bool limitTimerSet = SVFUtil::startAnalysisLimitTimer(Options::FsTimeLimit());
 
     double start = stat->getClk(true);
+    lastCheckpointTime = start;
     /// Start solving constraints
     DBOUT(DGENERAL, outs() << SVFUtil::pasMsg("Start Solving Constraints\n"));
 
+    if (!Options::FsResume().empty())
+        resumeFromCheckpoint(Options::FsResume());
+
     do
     {
         numOfIteration++;
@@ -106,6 +110,155 @@ void FlowSensitive::solveConstraints()
 
 }
 
+void FlowSensitive::solveWorklist()
+{
+    const u32_t gcInterval = Options::PtsGcInterval();
+    const bool checkpointing = !Options::FsCheckpoint().empty();
+    while (!isWorklistEmpty())
+    {
+        NodeID nodeId = popFromWorklist();
+        processNode(nodeId);
+        collapseFields();
+
+        // Between nodes nobody holds on to points-to sets, so it is safe to sweep.
+        if (gcInterval != 0 && ++numOfProcessedSinceSweep >= gcInterval) sweepPts();
+
+        if (checkpointing
+                && (stat->getClk(true) - lastCheckpointTime) / TIMEINTERVAL >= Options::FsCheckpointInterval())
+            writeCheckpoint(Options::FsCheckpoint());
+    }
+}
+
+void FlowSensitive::sweepPts(void)
+{
+    double start = stat->getClk();
+
+    u32_t rssBefore = 0, rssAfter = 0, vmsize = 0;
+    SVFUtil::getMemoryUsageKB(&rssBefore, &vmsize);
+
+    numOfReclaimedPts += sweepPtCache();
+    ++numOfPtsSweeps;
+    numOfProcessedSinceSweep = 0;
+
+    SVFUtil::getMemoryUsageKB(&rssAfter, &vmsize);
+    if (rssBefore > peakRSSAtSweep) peakRSSAtSweep = rssBefore;
+    if (rssBefore > rssAfter) reclaimedRSS += rssBefore - rssAfter;
+
+    double end = stat->getClk();
+    ptsSweepTime += (end - start) / TIMEINTERVAL;
+}
+
+/*!
+ * Write a checkpoint: field-insensitive objects, the IN/OUT sets, then
+ * top-level points-to sets and GepObjVars, as writeToFile does.
+ * The worklist and call graph are not stored. On resume every SVFG node is
+ * processed again and the call graph is re-derived from the points-to sets.
+ */
+void FlowSensitive::writeCheckpoint(const std::string& filename)
+{
+    double start = stat->getClk(true);
+
+    const std::string tmpFilename = filename + ".tmp";
+    // Same sections as writeObjVarToFile followed by writeToFile, without their progress messages.
+    std::fstream f(tmpFilename.c_str(), std::ios_base::out);
+    if (f.good())
+    {
+        writeObjFieldSensitivityToFile(f);
+        f << "------\n";
+        writeAddrTakenPtsToFile(f);
+        writePtsResultToFile(f);
+        f << "------\n";
+        writeGepObjVarMapToFile(f);
+        f << "------\n";
+        writeObjFieldSensitivityToFile(f);
+        f.close();
+    }
+    if (!f.good() || std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+        outs() << "  error writing checkpoint '" << filename << "'!\n";
+
+    ++numOfCheckpoints;
+    double end = stat->getClk(true);
+    checkpointTime += (end - start) / TIMEINTERVAL;
+    lastCheckpointTime = end;
+}
+
+bool FlowSensitive::resumeFromCheckpoint(const std::string& filename)
+{
+    double start = stat->getClk(true);
+
+    outs() << "Resuming flow-sensitive analysis from '" << filename << "'...";
+    std::ifstream F(filename.c_str());
+    if (!F.is_open())
+    {
+        outs() << "  error opening file for reading!\n";
+        return false;
+    }
+
+    readAndSetObjFieldSensitivity(F, "------");
+    readAddrTakenPtsFromFile(F);
+    readPtsResultFromFile(F);
+    readGepObjVarMapFromFile(F);
+    readAndSetObjFieldSensitivity(F, "");
+
+    // Reconnect indirect calls resolved before the checkpoint.
+    updateCallGraph(getIndirectCallsites());
+
+    F.close();
+    outs() << "\n";
+
+    double end = stat->getClk(true);
+    resumeTime += (end - start) / TIMEINTERVAL;
+    return true;
+}
+
+/*!
+ * Write IN/OUT sets to f, one "IN loc var -> { obj1 obj2 }"
+ * (or "OUT ...") line each, terminated by "---DF---".
+ */
+void FlowSensitive::writeAddrTakenPtsToFile(std::fstream& f)
+{
+    for (bool in : { true, false })
+    {
+        getDFPTDataTy()->visitDFPts(in, [&f, in](NodeID loc, const NodeID& var, const PointsTo& pts)
+        {
+            f << (in ? "IN " : "OUT ") << loc << " " << var << " -> { ";
+            for (NodeID o : pts) f << o << " ";
+            f << "}\n";
+        });
+    }
+
+    f << "---DF---\n";
+}
+
+void FlowSensitive::readAddrTakenPtsFromFile(std::ifstream& F)
+{
+    const std::string delimiter1 = " -> { ";
+    const std::string delimiter2 = " }";
+    std::string line;
+    while (F.good())
+    {
+        getline(F, line);
+        if (line == "---DF---") break;
+
+        size_t pos = line.find(delimiter1);
+        if (pos == std::string::npos || line.back() != '}') break;
+
+        // Parse "IN loc var" or "OUT loc var".
+        std::istringstream ss(line.substr(0, pos));
+        std::string kind;
+        NodeID loc, var;
+        ss >> kind >> loc >> var;
+
+        pos += delimiter1.length();
+        std::istringstream pt(line.substr(pos, line.length() - pos - delimiter2.length()));
+        PointsTo pts;
+        NodeID obj;
+        while (pt >> obj) pts.set(obj);
+
+        getDFPTDataTy()->unionDFPts(kind == "IN", loc, var, pts);
+    }
+}
+
 /*!
  * Start analysis
  */
@@ -153,6 +153,9 @@ void FlowSensitiveStat::performStat()
     timeStatMap["StoreTime"] = fspta->storeTime;
     timeStatMap["UpdateCGTime"] = fspta->updateCallGraphTime;
     timeStatMap["PhiTime"] = fspta->phiTime;
+    timeStatMap["PtsSweepTime"] = fspta->ptsSweepTime;
+    timeStatMap["CheckpointTime"] = fspta->checkpointTime;
+    timeStatMap["ResumeTime"] = fspta->resumeTime;
 
     PTNumStatMap["TotalPointers"] = pag->getValueNodeNum() + pag->getFieldValNodeNum();
     PTNumStatMap["TotalObjects"] = pag->getObjectNodeNum() + pag->getFieldObjNodeNum();
@@ -175,6 +178,13 @@ void FlowSensitiveStat::performStat()
 
     PTNumStatMap["StrongUpdates"] = fspta->svfgHasSU.count();
 
+    PTNumStatMap["PtsSweeps"] = fspta->numOfPtsSweeps;
+    PTNumStatMap["ReclaimedPts"] = fspta->numOfReclaimedPts;
+    PTNumStatMap["PeakRSSAtSweep(KB)"] = fspta->peakRSSAtSweep;
+    PTNumStatMap["ReclaimedRSS(KB)"] = fspta->reclaimedRSS;
+
+    PTNumStatMap["Checkpoints"] = fspta->numOfCheckpoints;
+
     /// SVFG nodes.
     PTNumStatMap["SNodesHaveIN"] = _NumOfSVFGNodesHaveInOut[IN];
     PTNumStatMap["SNodesHaveOUT"] = _NumOfSVFGNodesHaveInOut[OUT];
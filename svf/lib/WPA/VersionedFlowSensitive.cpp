@@ -15,6 +15,7 @@
 #include <queue>
 #include <thread>
 #include <mutex>
+#include <atomic>
 
 using namespace SVF;
 
@@ -32,6 +33,8 @@ VersionedFlowSensitive::VersionedFlowSensitive(SVFIR *_pag, PTATY type)
 {
     numPrelabeledNodes = numPrelabelVersions = 0;
     prelabelingTime = meldLabelingTime = versionPropTime = 0.0;
+    numParVersionPropRounds = numParVersionPropObjects = numParVersionPropUpdates = 0;
+    parVersionPropTime = 0.0;
     // We'll grab vPtD in initialize.
 
     for (SVFIR::const_iterator it = pag->begin(); it != pag->end(); ++it)
@@ -545,6 +548,13 @@ void VersionedFlowSensitive::removeAllIndirectSVFGEdges(void)
 
 void VersionedFlowSensitive::propagateVersion(NodeID o, Version v)
 {
+    if (parallelVersionProp())
+    {
+        // Picked up by propagatePendingVersions once the worklist drains.
+        pendingVersions[o].insert(v);
+        return;
+    }
+
     double start = stat->getClk();
 
     const std::vector<Version> &reliantVersions = getReliantVersions(o, v);
@@ -559,6 +569,13 @@ void VersionedFlowSensitive::propagateVersion(NodeID o, Version v)
 
 void VersionedFlowSensitive::propagateVersion(const NodeID o, const Version v, const Version vp, bool time/*=true*/)
 {
+    if (parallelVersionProp())
+    {
+        // vp is already a reliant version of v, so propagating all of v suffices.
+        pendingVersions[o].insert(v);
+        return;
+    }
+
     double start = time ? stat->getClk() : 0.0;
 
     const VersionedVar srcVar = atKey(o, v);
@@ -587,6 +604,177 @@ void VersionedFlowSensitive::propagateVersion(const NodeID o, const Version v, c
     if (time) versionPropTime += (end - start) / TIMEINTERVAL;
 }
 
+bool VersionedFlowSensitive::parallelVersionProp(void)
+{
+    return Options::VersionPropThreads() > 1;
+}
+
+void VersionedFlowSensitive::propagatePendingVersions(void)
+{
+    if (pendingVersions.empty()) return;
+
+    double start = stat->getClk(true);
+
+    // Objects are independent during version propagation: o:v only ever flows
+    // into o:v'. The parallel phase never writes to vPtD (or any other shared
+    // structure), so workers only need the points-to sets of the versions they
+    // may touch. Those are gathered sequentially up front, then each worker
+    // computes the full transitive propagation for its objects into private
+    // buffers which are written back sequentially.
+
+    // 1. Collect, for each object, every version reachable from its pending
+    //    versions and a stable reference to its current points-to set.
+    struct ObjectJob
+    {
+        NodeID o;
+        std::vector<Version> pending;
+        Map<Version, const PointsTo *> versionPts;
+        std::vector<std::pair<Version, PointsTo>> changed;
+    };
+
+    std::vector<ObjectJob> jobs;
+    jobs.reserve(pendingVersions.size());
+    for (const Map<NodeID, Set<Version>>::value_type &ovs : pendingVersions)
+    {
+        jobs.emplace_back();
+        ObjectJob &job = jobs.back();
+        job.o = ovs.first;
+
+        const Map<NodeID, Map<Version, std::vector<Version>>>::const_iterator osRelianceIt
+            = versionReliance.find(job.o);
+
+        FIFOWorkList<Version> reachable;
+        for (const Version v : ovs.second)
+        {
+            job.pending.push_back(v);
+            reachable.push(v);
+        }
+
+        while (!reachable.empty())
+        {
+            const Version v = reachable.pop();
+            if (job.versionPts.find(v) != job.versionPts.end()) continue;
+            job.versionPts[v] = &vPtD->getPts(atKey(job.o, v));
+
+            if (osRelianceIt == versionReliance.end()) continue;
+            const Map<Version, std::vector<Version>>::const_iterator reliantIt = osRelianceIt->second.find(v);
+            if (reliantIt == osRelianceIt->second.end()) continue;
+            for (const Version r : reliantIt->second)
+            {
+                if (job.versionPts.find(r) == job.versionPts.end()) reachable.push(r);
+            }
+        }
+    }
+
+    pendingVersions.clear();
+
+    // 2. Propagate each object's versions to a fixed point on worker threads.
+    std::atomic<size_t> nextJob(0);
+    auto propWorker = [this, &jobs, &nextJob](void)
+    {
+        while (true)
+        {
+            const size_t j = nextJob++;
+            if (j >= jobs.size()) return;
+
+            ObjectJob &job = jobs[j];
+            const Map<Version, std::vector<Version>> &osReliance = this->versionReliance.at(job.o);
+
+            // Versions updated by this job; everything else is read from versionPts.
+            Map<Version, PointsTo> updatedPts;
+            auto currentPts = [&job, &updatedPts](const Version v) -> const PointsTo &
+            {
+                const Map<Version, PointsTo>::const_iterator updatedIt = updatedPts.find(v);
+                if (updatedIt != updatedPts.end()) return updatedIt->second;
+                return *job.versionPts.at(v);
+            };
+
+            FIFOWorkList<Version> versionWorklist;
+            for (const Version v : job.pending) versionWorklist.push(v);
+
+            while (!versionWorklist.empty())
+            {
+                const Version v = versionWorklist.pop();
+                const Map<Version, std::vector<Version>>::const_iterator reliantIt = osReliance.find(v);
+                if (reliantIt == osReliance.end()) continue;
+
+                const PointsTo &vPts = currentPts(v);
+                if (vPts.empty()) continue;
+
+                for (const Version r : reliantIt->second)
+                {
+                    Map<Version, PointsTo>::iterator rIt = updatedPts.find(r);
+                    if (rIt == updatedPts.end())
+                    {
+                        const PointsTo &rPts = *job.versionPts.at(r);
+                        if (rPts.contains(vPts)) continue;
+                        rIt = updatedPts.emplace(r, rPts).first;
+                    }
+
+                    if (rIt->second |= vPts) versionWorklist.push(r);
+                }
+            }
+
+            for (std::pair<const Version, PointsTo> &vp : updatedPts)
+            {
+                job.changed.emplace_back(vp.first, std::move(vp.second));
+            }
+        }
+    };
+
+    double parStart = stat->getClk(true);
+    const unsigned numThreads = std::min<size_t>(Options::VersionPropThreads(), jobs.size());
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < numThreads; ++i) workers.push_back(std::thread(propWorker));
+    for (std::thread &worker : workers) worker.join();
+    double parEnd = stat->getClk(true);
+
+    // 3. Write back and notify statements relying on changed versions.
+    for (const ObjectJob &job : jobs)
+    {
+        for (const std::pair<Version, PointsTo> &vp : job.changed)
+        {
+            if (vPtD->unionPts(atKey(job.o, vp.first), vp.second))
+            {
+                ++numParVersionPropUpdates;
+                for (NodeID s : getStmtReliance(job.o, vp.first)) pushIntoWorklist(s);
+            }
+        }
+    }
+
+    ++numParVersionPropRounds;
+    numParVersionPropObjects += jobs.size();
+
+    double end = stat->getClk(true);
+    parVersionPropTime += (parEnd - parStart) / TIMEINTERVAL;
+    versionPropTime += (end - start) / TIMEINTERVAL;
+}
+
+void VersionedFlowSensitive::solveWorklist()
+{
+    if (!parallelVersionProp())
+    {
+        FlowSensitive::solveWorklist();
+        return;
+    }
+
+    // Alternate between processing statements (which record changed versions)
+    // and propagating those versions in bulk (which wakes up statements).
+    do
+    {
+        FlowSensitive::solveWorklist();
+        propagatePendingVersions();
+    }
+    while (!isWorklistEmpty());
+}
+
+void VersionedFlowSensitive::writeCheckpoint(const std::string& filename)
+{
+    // Versions recorded for the parallel phase are not in vPtD yet.
+    propagatePendingVersions();
+    FlowSensitive::writeCheckpoint(filename);
+}
+
 void VersionedFlowSensitive::processNode(NodeID n)
 {
     SVFGNode* sn = svfg->getSVFGNode(n);
@@ -1021,6 +1209,18 @@ void VersionedFlowSensitive::writeVersionedAnalysisResultToFile(const std::strin
         return;
     }
 
+    writeVersionedPtsToFile(f);
+
+    f.close();
+    if (f.good())
+    {
+        SVFUtil::outs() << "\n";
+        return;
+    }
+}
+
+void VersionedFlowSensitive::writeVersionedPtsToFile(std::fstream& f)
+{
     for (const VersionedFlowSensitive::LocVersionMap *lvm :
             {
                 &this->consume, &this->yield
@@ -1053,13 +1253,6 @@ void VersionedFlowSensitive::writeVersionedAnalysisResultToFile(const std::strin
     }
 
     f << "---VERSIONED---\n";
-
-    f.close();
-    if (f.good())
-    {
-        SVFUtil::outs() << "\n";
-        return;
-    }
 }
 
 void VersionedFlowSensitive::readVersionedAnalysisResultFromFile(std::ifstream& F)
@@ -11,6 +11,7 @@
 #include "WPA/WPAStat.h"
 #include "WPA/VersionedFlowSensitive.h"
 #include "MemoryModel/PointsTo.h"
+#include "Util/Options.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -97,6 +98,10 @@ void VersionedFlowSensitiveStat::performStat()
     timeStatMap["meldLabelingTime"]   = vfspta->meldLabelingTime;
     timeStatMap["PrelabelingTime"]    = vfspta->prelabelingTime;
     timeStatMap["VersionPropTime"]    = vfspta->versionPropTime;
+    timeStatMap["ParVersionPropTime"] = vfspta->parVersionPropTime;
+    timeStatMap["PtsSweepTime"]       = vfspta->ptsSweepTime;
+    timeStatMap["CheckpointTime"]     = vfspta->checkpointTime;
+    timeStatMap["ResumeTime"]         = vfspta->resumeTime;
 
     PTNumStatMap["TotalPointers"]  = pag->getValueNodeNum() + pag->getFieldValNodeNum();
     PTNumStatMap["TotalObjects"]   = pag->getObjectNodeNum() + pag->getFieldObjNodeNum();
@@ -118,10 +123,22 @@ void VersionedFlowSensitiveStat::performStat()
 
     PTNumStatMap["SolveIterations"] = vfspta->numOfIteration;
 
+    PTNumStatMap["VersionPropThreads"]    = Options::VersionPropThreads();
+    PTNumStatMap["ParVersionPropRounds"]  = vfspta->numParVersionPropRounds;
+    PTNumStatMap["ParVersionPropObjects"] = vfspta->numParVersionPropObjects;
+    PTNumStatMap["ParVersionPropUpdates"] = vfspta->numParVersionPropUpdates;
+
     PTNumStatMap["IndEdgeSolved"] = vfspta->getNumOfResolvedIndCallEdge();
 
     PTNumStatMap["StrongUpdates"] = vfspta->svfgHasSU.count();
 
+    PTNumStatMap["PtsSweeps"]          = vfspta->numOfPtsSweeps;
+    PTNumStatMap["ReclaimedPts"]       = vfspta->numOfReclaimedPts;
+    PTNumStatMap["PeakRSSAtSweep(KB)"] = vfspta->peakRSSAtSweep;
+    PTNumStatMap["ReclaimedRSS(KB)"]   = vfspta->reclaimedRSS;
+
+    PTNumStatMap["Checkpoints"] = vfspta->numOfCheckpoints;
+
     PTNumStatMap["MaxPtsSize"]        = _MaxPtsSize;
     PTNumStatMap["MaxTopLvlPtsSize"]  = _MaxTopLvlPtsSize;
     PTNumStatMap["MaxVersionPtsSize"] = _MaxVersionPtsSize;